@@ -35,6 +35,7 @@
 #include "Button.h"
 #include "Components.h"
 #include "FluidSystem.h"
+#include "TriggerRegistry.h"
 #include "VFXSystem.h"
 
 // ==========================================
@@ -68,7 +69,7 @@ struct Collectible {
 // ==========================================
 // COLLECTIBLE SYSTEM
 // ==========================================
-class CollectibleSystem {
+class CollectibleSystem : public ITriggerListener {
 private:
     AEGfxVertexList* starMesh_{nullptr};
     AEGfxVertexList* gemMesh_{nullptr};
@@ -83,11 +84,17 @@ private:
 
     float globalTimer_{0.0f};
 
+    VFXSystem* vfxSystem_{nullptr}; // Target of the VFX spawned by this frame's trigger hits
+
 public:
     void load(s8 font);
     void initialize();
     void loadLevelCollectibles(AEVec2 pos, CollectibleType type);
-    void update(f32 dt, std::vector<FluidParticle>& particlePool, VFXSystem& vfxSystem);
+    void update(f32 dt, FluidSystem& fluidSystem, VFXSystem& vfxSystem);
+    // Animation only, for screens that show collectibles without any water
+    void animate(f32 dt);
+    void onTriggerHits(u32 tag, const std::vector<u32>& particleIndices,
+                       TriggerRegistry& registry, FluidSystem& fluidSystem) override;
     void draw();
     void drawPreview();
     void drawUI();
@@ -104,6 +111,6 @@ public:
 
 private:
     void createMeshes();
-    bool checkCollisionWithWater(const Collectible& collectible, const FluidParticle& particle);
+    void updateCollectionText();
     void drawCollectible(const Collectible& c);
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+/*!
+@file       Collider2D.h
+@author     Sean Lee Hong Wei/seanhongwei.lee@digipen.edu
+@co_author  Chia Hanxin/c.hanxin@digipen.edu
+
+@date		March, 31, 2026
+
+@brief      This header file defines the Collider2D component and its shape
+            data. It only needs the engine's plain math types, so the
+            compile-time terrain collider tables can use it without pulling
+            in the rest of the engine.
+
+@copyright  Copyright (C) 2026 DigiPen Institute of Technology.
+            Reproduction or disclosure of this file or its contents
+            without the prior written consent of DigiPen Institute of
+            Technology is prohibited.
+*//*______________________________________________________________________*/
+#pragma once
+
+// Third-party
+#include <AETypes.h>
+#include <AEVec2.h>
+
+// Identifies which collider shape variant is active in Collider2D.
+enum class ColliderShape { Empty, Circle, Box, Triangle };
+
+// Collider data for a circle: offset from the object's position and radius.
+struct CircleColliderData {
+    AEVec2 offset_;
+    f32 radius_;
+};
+
+// Collider data for an axis-aligned box: offset and half-extents size.
+struct BoxColliderData {
+    AEVec2 offset_;
+    AEVec2 size_;
+};
+
+// Collider data for a triangle: three vertices in local space.
+struct TriangleColliderData {
+    AEVec2 vertices_[3];
+};
+
+// Shape data of a Collider2D, only the member matching the shape tag is active. The constructors
+// let a specific shape be chosen in a constant expression (e.g. the terrain collider table).
+union ColliderShapeData {
+    CircleColliderData circle_;
+    BoxColliderData box_;
+    TriangleColliderData triangle_;
+
+    constexpr ColliderShapeData() : circle_{} {}
+    constexpr ColliderShapeData(const CircleColliderData& circle) : circle_{circle} {}
+    constexpr ColliderShapeData(const BoxColliderData& box) : box_{box} {}
+    constexpr ColliderShapeData(const TriangleColliderData& triangle) : triangle_{triangle} {}
+};
+
+// Holds a collider shape tag and the corresponding shape data as a union.
+struct Collider2D {
+    ColliderShape colliderShape_{ColliderShape::Empty};
+    ColliderShapeData shapeData_{};
+};
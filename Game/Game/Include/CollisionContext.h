@@ -0,0 +1,119 @@
+/*!
+@file       CollisionContext.h
+@author     Sean Lee Hong Wei/seanhongwei.lee@digipen.edu
+@co_author  Woo Guang Theng/guangtheng.woo@digipen.edu,
+            Chia Hanxin/c.hanxin@digipen.edu
+
+@date		March, 31, 2026
+
+@brief      This header file contains the declarations of the per-world state
+            used by the collision system which includes the following:
+
+                - TriggerSystem, an enumeration of the gameplay systems that
+                  run their own trigger checks against fluid particles.
+                - CollisionStats and BroadphaseStats, per-frame counters used
+                  by the debug overlay and the collision stats dump.
+                - FluidGrid, the fluid broadphase bucket grid.
+                - CollisionContext, which bundles the scratch buffers and
+                  counters of one simulation world so that several worlds can
+                  step at the same time without sharing state.
+
+@copyright  Copyright (C) 2026 DigiPen Institute of Technology.
+            Reproduction or disclosure of this file or its contents
+            without the prior written consent of DigiPen Institute of
+            Technology is prohibited.
+*//*______________________________________________________________________*/
+#pragma once
+// ==========================================
+//              Includes
+// ==========================================
+
+// Standard library
+#include <ostream>
+#include <utility>
+#include <vector>
+
+// Third-party
+#include <AEEngine.h>
+
+// Defined in FluidSystem.h, which owns a CollisionContext
+enum class FluidType;
+
+// ==========================================
+//              TriggerSystem
+// ==========================================
+// Gameplay systems that run their own trigger checks against fluid particles.
+enum class TriggerSystem { Portal, Moss, Collectible, EndPoint, Count };
+
+// ==========================================
+//              CollisionStats
+// ==========================================
+// Per-frame collision work broken down by phase, so the debug overlay can show where the time
+// goes instead of a single collision count.
+struct CollisionStats {
+    u32 fluidPairsTested_ = 0;     // Broadphase candidate pairs sent to the narrowphase
+    u32 fluidPairsResolved_ = 0;   // Pairs that actually overlapped
+    u32 terrainCellsTested_ = 0;   // Terrain cells (or cached colliders) tested per particle
+    u32 terrainCellsHit_ = 0;      // Terrain tests that produced a contact
+    u32 terrainWarmStartHits_ = 0; // Contacts resolved from the per-particle contact cache
+    u32 triggerChecks_[static_cast<int>(TriggerSystem::Count)] = {};
+    u32 triggerHits_[static_cast<int>(TriggerSystem::Count)] = {};
+    u32 gridBuilds_ = 0;         // Broadphase grid builds this frame
+    f32 gridBuildTimeMs_ = 0.0f; // Total time spent building the broadphase grid
+
+    // Total contacts of every kind, the old single collision count.
+    u32 totalHits() const;
+
+    // Records one trigger-vs-particle check made by a gameplay system.
+    void recordTriggerCheck(TriggerSystem system, bool hit);
+
+    // Records the particles tested and hit by one trigger volume of a gameplay system.
+    void recordTriggerChecks(TriggerSystem system, u32 checks, u32 hits);
+};
+
+// ==========================================
+//              BroadphaseStats
+// ==========================================
+// Occupancy of the fluid broadphase grid from the most recent build, used to tune the
+// broadphase cell size per level.
+struct BroadphaseStats {
+    f32 cellSize_ = 0.0f;        // World size of a single bucket
+    u32 cols_ = 0;               // Bucket columns
+    u32 rows_ = 0;               // Bucket rows
+    u32 occupiedBuckets_ = 0;    // Buckets holding at least one particle
+    u32 maxPerBucket_ = 0;       // Fullest bucket
+    f32 avgPerOccupied_ = 0.0f;  // Mean particles per occupied bucket
+    u32 outOfGridParticles_ = 0; // Particles outside the grid that were not bucketed
+};
+
+// ==========================================
+//              FluidGrid
+// ==========================================
+// Standalone fluid broadphase grid. Its bucket size follows the particle interaction radius
+// instead of the terrain's cell size, so tile size no longer dictates broadphase density.
+struct FluidGrid {
+    using BucketEntry = std::pair<FluidType, u32>; // (type, index)
+
+    std::vector<std::vector<BucketEntry>> buckets_;
+    AEVec2 bottomLeftPos_{0.0f, 0.0f};
+    f32 cellSize_ = 0.0f;
+    u32 cols_ = 0;
+    u32 rows_ = 0;
+};
+
+// ==========================================
+//              CollisionContext
+// ==========================================
+// Everything the collision system used to keep in statics. Each simulation world (FluidSystem)
+// owns one, so the level, the menu background and any headless run never share buffers.
+struct CollisionContext {
+    FluidGrid fluidGrid_;
+    CollisionStats frameStats_;
+    BroadphaseStats broadphaseStats_;
+
+    // Clears the per-frame counters, called once the frame's stats have been read.
+    void resetFrameStats() { frameStats_ = CollisionStats{}; }
+
+    // Writes the current frame stats as a single-line JSON object (one line per frame).
+    void writeFrameStats(std::ostream& os, u32 frame) const;
+};
@@ -9,7 +9,7 @@
 @brief      This source file contains the declarations of functions and classes
             for the collision detection and resolution system which includes the following:
 
-                - CollisionSystem, a static utility class that manages spatial
+                - CollisionSystem, a stateless utility class that manages spatial
                   partitioning, intersection detection, and physics resolution
                   between fluid particles and terrain geometry.
                 - Geometric Utility functions for point-in-triangle tests,
@@ -40,6 +40,7 @@
 #include <AEEngine.h>
 
 // Project
+#include "CollisionContext.h"
 #include "Components.h"
 #include "FluidSystem.h"
 #include "Terrain.h"
@@ -51,21 +52,20 @@ struct CollisionInfo {
     bool hasCollision_ = false;
     AEVec2 normal_ = {0.0f, 1.0f};
     f32 penetration_ = 0.0f;
+    s32 colliderSlot_ = -1; // Slot in Cell::colliders_ that produced the contact
 };
 
 // ==========================================
 //              CollisionSystem
 // ==========================================
+// Stateless: every scratch buffer and counter lives in the CollisionContext owned by the
+// FluidSystem being stepped, so separate worlds can collide concurrently on different threads.
 class CollisionSystem {
 public:
     static void terrainToFluidCollision(Terrain& terrain, FluidSystem& fluidSystem, f32 dt = {});
 
-    static u32 getLastFrameCollisionCount() { return collisionCount_; }
-    static void resetCollisionCount() { collisionCount_ = 0; }
-    static void incrementCollisionCount() { ++collisionCount_; }
-
 private:
-    using BucketEntry = std::pair<FluidType, u32>;
+    using BucketEntry = FluidGrid::BucketEntry;
 
     // -----------------------------
     // Minimal vector helpers
@@ -78,7 +78,7 @@ private:
 
     static AEVec2 vNormalizeOr(const AEVec2& v, const AEVec2& fallback);
 
-    static AEVec2 localToWorldPoint(const AEVec2& local, const Transform& t);
+    static AEVec2 localToWorldPoint(const AEVec2& local, const Cell& cell);
 
     static AEVec2 closestPointOnSegment(const AEVec2& a, const AEVec2& b, const AEVec2& p);
 
@@ -86,9 +86,14 @@ private:
     static bool pointInTriangle(const AEVec2& p, const AEVec2& a, const AEVec2& b, const AEVec2& c);
 
     // Helper function (terrainToFluidCollision): Returns a CollisionContact struct containing
-    // information about collision.
+    // information about collision. skipSlot leaves out a slot already resolved this substep.
     static CollisionInfo cellToFluidParticleCollision(const Cell& cell,
-                                                      const FluidParticle& fluidParticle);
+                                                      const FluidParticle& fluidParticle,
+                                                      s32 skipSlot = -1);
+
+    // Helper function (cellToFluidParticleCollision): Tests a single collider slot of a cell.
+    static CollisionInfo colliderToFluidParticleCollision(const Cell& cell, u32 slot,
+                                                          const FluidParticle& fluidParticle);
 
     // Helper function (cellToFluidParticleCollision): circle vs AABB (axis-aligned box) in world
     static bool detectCircleVsAABB(const AEVec2& circleCenter, f32 radius, const AEVec2& velocity,
@@ -100,15 +105,24 @@ private:
                                        const AEVec2& velocity, const AEVec2& v0, const AEVec2& v1,
                                        const AEVec2& v2, AEVec2& outNormal, f32& outPenetration);
 
-    // Collision Resolution function.
+    // Collision Resolution function. persistentContact skips the floor impact spread for contacts
+    // carried over from the previous substep.
     static void pushOutAndSlide(FluidParticle& p, const AEVec2& n, f32 penetration, f32 radius,
-                                f32 dt);
+                                f32 dt, bool persistentContact = false);
+
+    static void resolveFluidParticlePair(FluidParticle& p1, FluidParticle& p2,
+                                         CollisionStats& stats);
 
-    static void resolveFluidParticlePair(FluidParticle& p1, FluidParticle& p2);
+    // Buckets every particle of the fluid system into the grid at its current size.
+    static void buildGrid(FluidGrid& fluidGrid, FluidSystem& fluidSystem,
+                          BroadphaseStats& broadphaseStats);
 
-    static void buildGrid(std::vector<std::vector<BucketEntry>>& fluidGrid,
-                          FluidSystem& fluidSystem, const AEVec2& gridBottomLeftPos, u32 gridCols,
-                          u32 gridRows, u32 gridSize);
+    // Sizes the broadphase grid to cover the given world area using the fluid system's
+    // broadphase cell size.
+    static void resizeGrid(FluidGrid& fluidGrid, const FluidSystem& fluidSystem,
+                           const AEVec2& areaBottomLeftPos, f32 areaWidth, f32 areaHeight);
 
-    static u32 collisionCount_;
+    // Narrowphase of a single particle against every terrain cell its collider overlaps.
+    static void particleToTerrainCollision(Terrain& terrain, FluidParticle& fluidParticle, f32 dt,
+                                           CollisionStats& stats);
 };
@@ -6,7 +6,9 @@
 @date		March, 31, 2026
 
 @brief      This header file defines the core component structs used across
-            game objects: Transform, Graphics, RigidBody2D, and Collider2D.
+            game objects: Transform, Graphics, RigidBody2D, and Collider2D
+            (defined in Collider2D.h), and the one-step world matrix path
+            shared by the systems that rebuild their matrices every frame.
 
 @copyright  Copyright (C) 2026 DigiPen Institute of Technology.
             Reproduction or disclosure of this file or its contents
@@ -18,6 +20,9 @@
 // Third-party
 #include <AEEngine.h>
 
+// Project
+#include "Collider2D.h"
+
 // Stores position, scale, rotation, and the computed world matrix.
 struct Transform {
     AEVec2 pos_{0.0f, 0.0f};
@@ -26,6 +31,60 @@ struct Transform {
     AEMtx33 worldMtx_{};
 };
 
+// Writes trans * rot * scale for a uniform scale straight into out, without building the three
+// matrices and concatenating them.
+inline void composeWorldMtx(AEMtx33& out, const AEVec2& pos, f32 scale, f32 cosRotation,
+                            f32 sinRotation) {
+    out.m[0][0] = scale * cosRotation;
+    out.m[0][1] = -scale * sinRotation;
+    out.m[0][2] = pos.x;
+    out.m[1][0] = scale * sinRotation;
+    out.m[1][1] = scale * cosRotation;
+    out.m[1][2] = pos.y;
+    out.m[2][0] = 0.0f;
+    out.m[2][1] = 0.0f;
+    out.m[2][2] = 1.0f;
+}
+
+// Same, for an unrotated object.
+inline void composeWorldMtx(AEMtx33& out, const AEVec2& pos, f32 scale) {
+    composeWorldMtx(out, pos, scale, 1.0f, 0.0f);
+}
+
+// The inputs a Transform's world matrix was last composed from, kept next to the Transform of
+// objects that mostly sit still (such as moss), with a uniform scale (scale_.x) and an optional
+// rotation. Objects that move every frame call composeWorldMtx directly.
+struct WorldMtxCache {
+    AEVec2 pos_{0.0f, 0.0f};
+    f32 scale_{0.0f};
+    f32 rotationRad_{0.0f};
+    f32 cosRotation_{1.0f};
+    f32 sinRotation_{0.0f};
+    bool valid_{false}; // False until the first compose, or to force the next one
+};
+
+// Recomposes transform.worldMtx_ only if its position, scale or rotation changed since the last
+// call. The rotation's cosine and sine are only re-evaluated when the rotation changed. Returns
+// true if the matrix was rewritten.
+inline bool updateWorldMtx(Transform& transform, WorldMtxCache& cache) {
+    const bool rotationDirty = !cache.valid_ || transform.rotationRad_ != cache.rotationRad_;
+    if (!rotationDirty && transform.pos_.x == cache.pos_.x && transform.pos_.y == cache.pos_.y &&
+        transform.scale_.x == cache.scale_)
+        return false;
+
+    if (rotationDirty) {
+        cache.rotationRad_ = transform.rotationRad_;
+        cache.cosRotation_ = AECos(transform.rotationRad_);
+        cache.sinRotation_ = AESin(transform.rotationRad_);
+    }
+    cache.pos_ = transform.pos_;
+    cache.scale_ = transform.scale_.x;
+    cache.valid_ = true;
+    composeWorldMtx(transform.worldMtx_, cache.pos_, cache.scale_, cache.cosRotation_,
+                    cache.sinRotation_);
+    return true;
+}
+
 // Stores mesh, texture, draw layer, and RGBA tint for rendering.
 struct Graphics {
     AEGfxVertexList* mesh_{nullptr};
@@ -45,33 +104,3 @@ struct RigidBody2D {
     // AEVec2 acceleration_{0.0f, 0.0f};
     // AEVec2 forces_{0.0f, 0.0f};
 };
-
-// Identifies which collider shape variant is active in Collider2D.
-enum class ColliderShape { Empty, Circle, Box, Triangle };
-
-// Collider data for a circle: offset from the object's position and radius.
-struct CircleColliderData {
-    AEVec2 offset_;
-    f32 radius_;
-};
-
-// Collider data for an axis-aligned box: offset and half-extents size.
-struct BoxColliderData {
-    AEVec2 offset_;
-    AEVec2 size_;
-};
-
-// Collider data for a triangle: three vertices in local space.
-struct TriangleColliderData {
-    AEVec2 vertices_[3];
-};
-
-// Holds a collider shape tag and the corresponding shape data as a union.
-struct Collider2D {
-    ColliderShape colliderShape_{ColliderShape::Empty};
-    union {
-        CircleColliderData circle_;
-        BoxColliderData box_;
-        TriangleColliderData triangle_;
-    } shapeData_{};
-};
@@ -17,6 +17,7 @@
 #pragma once
 
 // Standard library
+#include <fstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -31,16 +32,24 @@
 #include "GameStateManager.h"
 
 class CollectibleSystem;
+struct Cell;
+struct CollisionContext;
 class FluidSystem;
 class PortalSystem;
 class StartEndPoint;
 class Terrain;
 class VFXSystem;
 
+// A single HUD text line: a printf-style format applied to one entry of hudValues_.
+struct DebugHudLine {
+    std::string valueKey_; // Key used to look up the value in hudValues_
+    std::string format_;   // printf-style format string taking one float
+};
+
 // Represents a single toggleable debug option with a checkbox button and label.
 struct DebugToggle {
-    std::string key_;       // Key used to look up the toggle in options_
-    std::string hudFormat_; // Optional printf-style format string for HUD display
+    std::string key_;                    // Key used to look up the toggle in options_
+    std::vector<DebugHudLine> hudLines_; // Optional HUD lines shown while the toggle is on
     Button checkbox_;
     TextData label_;
 };
@@ -71,7 +80,7 @@ public:
     // Toggle states keyed by name — read directly by game systems each frame.
     std::unordered_map<std::string, bool> options_;
 
-    // Numeric values displayed on the HUD, keyed by toggle name.
+    // Numeric values displayed on the HUD, keyed by toggle name or hudLines value key.
     std::unordered_map<std::string, float> hudValues_;
 
     // Handles checkbox click input and updates toggle states.
@@ -87,9 +96,8 @@ public:
     void drawAll();
 
     // Registers scene system pointers so drawAll() can iterate them each frame.
-    void setScene(Terrain* dirt, Terrain* stone, Terrain* magic, FluidSystem* fluidSystem,
-                  CollectibleSystem* collectibles, PortalSystem* portals, StartEndPoint* startEnd,
-                  VFXSystem* vfx = nullptr);
+    void setScene(Terrain* terrain, FluidSystem* fluidSystem, CollectibleSystem* collectibles,
+                  PortalSystem* portals, StartEndPoint* startEnd, VFXSystem* vfx = nullptr);
 
     // Clears all registered scene pointers.
     void clearScene();
@@ -101,6 +109,9 @@ private:
     // Draws the semi-transparent background quad for the overlay.
     void renderBackground();
 
+    // Copies a world's collision stats into hudValues_, writes the stats dump, then resets them.
+    void updateCollisionStats(CollisionContext& context);
+
     // Draws the collider wireframe for a single object.
     void drawSingleCollider(const Transform& transform, const Collider2D& col);
 
@@ -113,6 +124,9 @@ private:
     // Draws collider wireframes for all active cells in a terrain layer.
     void drawTerrainColliders(Terrain& terrain);
 
+    // Draws the collider wireframes of a single terrain cell.
+    void drawCellColliders(const Cell& cell);
+
     // Draws collider wireframes for all fluid particles.
     void drawFluidColliders(FluidSystem& fluidSystem);
 
@@ -129,9 +143,7 @@ private:
     s8 font_{0};
 
     // Scene objects registered by the current game state
-    Terrain* dirt_{nullptr};
-    Terrain* stone_{nullptr};
-    Terrain* magic_{nullptr};
+    Terrain* terrain_{nullptr};
     FluidSystem* fluidSystem_{nullptr};
     CollectibleSystem* collectibles_{nullptr};
     PortalSystem* portals_{nullptr};
@@ -148,6 +160,10 @@ private:
 
     Button buttonClose_;
     std::vector<DebugToggle> toggles_;
+
+    // Collision stats capture written while DumpCollisionStats is on
+    std::ofstream statsDumpFile_;
+    u32 statsDumpFrame_{0};
 };
 
 extern DebugSystem g_debugSystem;
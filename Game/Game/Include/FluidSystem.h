@@ -15,7 +15,8 @@
                   with transform, physics, and collider components.
                 - FluidSystem, a manager class that handles the initialization,
                   spawning, physics updates, and rendering for all active
-                  fluid particle pools.
+                  fluid particle pools, and runs the single trigger pass of
+                  the gameplay systems.
 
 @copyright  Copyright (C) 2026 DigiPen Institute of Technology.
             Reproduction or disclosure of this file or its contents
@@ -35,14 +36,29 @@
 #include <AEEngine.h>
 
 // Project
+#include "CollisionContext.h"
 #include "Components.h"
 #include "Terrain.h"
+#include "TriggerRegistry.h"
 
 // ==========================================
 //               FluidType
 // ==========================================
 enum class FluidType { Water, Lava, Count };
 
+// ==========================================
+//            TerrainContactCache
+// ==========================================
+// The terrain collider a particle touched last substep. It is re-tested first on the next
+// substep so settled water skips the full neighbourhood search.
+struct TerrainContactCache {
+    const Terrain* terrain_{nullptr}; // Terrain owning the contact, nullptr when there is none
+    u32 generation_{0};               // terrain_->getGeneration() when the contact was made
+    u32 cellIndex_{0};                // Index passed to terrain_->getCell()
+    u32 colliderSlot_{0};             // Index into Cell::colliders_
+    AEVec2 normal_{0.0f, 1.0f};       // Contact normal when the contact was made or refreshed
+};
+
 // ==========================================
 //               FluidParticle
 // ==========================================
@@ -57,6 +73,10 @@ struct FluidParticle {
     f32 portalIframeTimer_{0.15f};       // <--- timer for portal iframe
     f32 portalIframeMaxduration_{0.15f}; // <--- duration of portal iframe in seconds
 
+    s32 sourceIndex_{-1}; // <--- start point that emitted this particle, -1 if none
+
+    TerrainContactCache terrainContact_; // <--- warm-start contact for terrain collision
+
     FluidParticle(f32 posX, f32 posY, f32 radius, FluidType type);
 };
 
@@ -77,12 +97,44 @@ public:
 
     void free();
 
-    void spawnParticle(f32 posX, f32 posY, f32 radius, FluidType type);
+    void spawnParticle(f32 posX, f32 posY, f32 radius, FluidType type, s32 sourceIndex = -1);
 
     u32 getParticleCount(FluidType type);
 
     std::vector<FluidParticle>& getParticlePool(FluidType type);
 
+    // Removes the particles at the given pool indices in one compaction. The indices may be
+    // unsorted or repeated, and are sorted in place.
+    void removeParticles(FluidType type, std::vector<u32>& indices);
+
+    // World size of a fluid broadphase bucket. Never smaller than the largest contact distance
+    // between two particles, so a 3x3 bucket search finds every overlapping pair.
+    f32 getBroadphaseCellSize() const;
+
+    // Collision scratch buffers and per-frame stats belonging to this simulation world.
+    CollisionContext& getCollisionContext();
+    const CollisionContext& getCollisionContext() const;
+
+    // Trigger volumes the gameplay systems registered this frame
+    TriggerRegistry& getTriggerRegistry();
+
+    // Runs the frame's single trigger pass: tests the water pool once against every registered
+    // volume and dispatches the hits. Call once after every trigger system has registered.
+    void dispatchTriggers();
+
+    // Particles reclaimed by the world bounds / kill plane in the last update and in total.
+    u32 getCulledLastFrame() const;
+    u32 getCulledTotal() const;
+
+    // Returns how many culled particles emitted by a start point are waiting to be refunded to
+    // it, and clears that count.
+    u32 takeCulledFromSource(s32 sourceIndex);
+
+    // Whether culled water is returned to its pipe. Off unless FluidSystem.json or the level's
+    // "Map" section opts in; set after initialize(), which reloads the config value.
+    void setRefundCulledWater(bool refund) { refundCulledWater_ = refund; }
+    bool getRefundCulledWater() const { return refundCulledWater_; }
+
 private:
     // particles[0] holds Water, particles[1] holds Lava, etc, stores live particles
     std::vector<FluidParticle> particlePools_[static_cast<int>(FluidType::Count)];
@@ -92,6 +144,27 @@ private:
 
     RigidBody2D physicsConfigs_[static_cast<int>(FluidType::Count)];
 
+    // Per-world collision state, so separate FluidSystems never share buffers
+    CollisionContext collisionContext_;
+
+    TriggerRegistry triggerRegistry_;
+
+    // Broadphase bucket size from FluidSystem.json, 0 derives it from the particle radius
+    f32 broadphaseCellSize_{0.0f};
+
+    // Largest collider radius spawned so far, the interaction radius of the broadphase
+    f32 maxColliderRadius_{0.0f};
+
+    // Out-of-bounds culling, configured from the "Culling" section of FluidSystem.json
+    bool cullingEnabled_{true};
+    f32 boundsMargin_{200.0f};   // Slack around the terrain on the left, right and top
+    f32 killPlaneOffset_{40.0f}; // Distance below the terrain's bottom edge
+    bool refundCulledWater_{false};
+
+    u32 culledLastFrame_{0};
+    u32 culledTotal_{0};
+    std::vector<u32> culledBySource_; // Pending refunds, indexed by start point
+
     void initializeGraphics(AEGfxVertexList* mesh_, AEGfxTexture* texture_, u32 layer_, f32 red,
                             f32 green, f32 blue, f32 alpha, FluidType type, u32 graphicsIndex);
 
@@ -102,4 +175,7 @@ private:
     void updatePhysics(std::vector<FluidParticle>& particlePool, f32 dt);
 
     void updatePortalIframes(f32 dt, std::vector<FluidParticle>& particlePool);
+
+    void cullOutOfBounds(std::vector<FluidParticle>& particlePool, const AEVec2& boundsMin,
+                         const AEVec2& boundsMax);
 };
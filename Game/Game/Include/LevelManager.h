@@ -116,8 +116,9 @@ public:
     // ==========================================
     // Each save function populates savingRoot_. Call writeToFile() afterward
     // to flush everything to disk in one operation.
-    void saveMapInfo(int width, int height, int tilesize, int portalLimit);
-    void saveTerrainInfo(std::vector<float>& nodes, const std::string& terrainType);
+    void saveMapInfo(int width, int height, int tilesize, int portalLimit,
+                     bool refundToPipe = false);
+    void saveTerrainInfo(const Terrain& terrain);
     void saveStartEndInfo(std::vector<StartEnd>& startPoints, StartEnd& endPoint);
     void saveCollectibleInfo(std::vector<Collectible>& collectibles);
     void saveMossInfo(std::vector<Moss>& mosses);
@@ -132,7 +133,9 @@ public:
     int getHighScore(int level) const;
     bool saveLevelProgress(int level, int collectedCount);
     void parseMapInfo(int& width, int& height, int& tilesize, int& portalLimit);
+    bool parseRefundToPipe(bool fallback) const;
     void parseTerrainInfo(std::vector<float>& nodes, std::string terrainType);
+    void parseTerrainInfo(Terrain& terrain);
     void parseStartEndInfo(StartEndPoint& startEndPointSystem);
     void parseCollectibleInfo(CollectibleSystem& collectibleSystem);
     void parseMossInfo(MossSystem& mossSystem);
@@ -0,0 +1,316 @@
+/*!
+@file       MarchingSquares.h
+@author     Sean Lee Hong Wei/seanhongwei.lee@digipen.edu
+@co_author  Woo Guang Theng/guangtheng.woo@digipen.edu
+
+@date		March, 31, 2026
+
+@brief      This header file contains the compile-time geometry of the 16
+            marching-squares cases used by the terrain, which includes the
+            following:
+
+                - kCaseTriangles, the render triangles of each case, baked into
+                  the chunk meshes by TerrainMeshBuilder.
+                - kCaseColliders, the box and triangle colliders of each case,
+                  used by the fluid collision.
+                - kSmoothCaseColliders, the render triangles as colliders, used
+                  when the edge midpoints are moved by the node densities.
+                - CellEdges and placeVertex, which slide the edge midpoints of a
+                  case to the interpolated crossings of a density field.
+                - Constant expression checks that the tables cover exactly the
+                  same area and agree with the corner bits of each case.
+
+@copyright  Copyright (C) 2026 DigiPen Institute of Technology.
+            Reproduction or disclosure of this file or its contents
+            without the prior written consent of DigiPen Institute of
+            Technology is prohibited.
+*//*______________________________________________________________________*/
+#pragma once
+
+// Third-party
+// Only the plain math types, so the mesh builder and the tables build without the engine
+#include <AETypes.h>
+#include <AEVec2.h>
+
+// Project
+#include "Collider2D.h"
+
+namespace MarchingSquares {
+// Cell corners and edge midpoints in local units, the cell spans [-0.5, 0.5]
+constexpr f32 kL{-0.5f}, kR{0.5f}, kB{-0.5f}, kT{0.5f}, kM{0.0f};
+
+// Where the surface crosses each edge of a cell in local units, 0 being the midpoint. The bottom
+// and top crossings are x offsets, the left and right ones y offsets.
+struct CellEdges {
+    f32 bottom_{0.0f};
+    f32 right_{0.0f};
+    f32 top_{0.0f};
+    f32 left_{0.0f};
+};
+
+// Moves a table vertex lying on an edge midpoint to that edge's crossing, corners are unchanged
+constexpr AEVec2 placeVertex(const AEVec2& vertex, const CellEdges& edges) {
+    if (vertex.x == kM)
+        return {vertex.y == kB ? edges.bottom_ : edges.top_, vertex.y};
+    if (vertex.y == kM)
+        return {vertex.x, vertex.x == kL ? edges.left_ : edges.right_};
+    return vertex;
+}
+
+// Triangles of one marching-squares case (TL=8, TR=4, BR=2, BL=1)
+struct CaseTriangles {
+    u32 count_;
+    AEVec2 vertices_[3][3];
+};
+
+inline constexpr CaseTriangles kCaseTriangles[16]{
+    // 0: Empty
+    {0, {}},
+    // 1: BL
+    {1, {{{kL, kB}, {kM, kB}, {kL, kM}}}},
+    // 2: BR
+    {1, {{{kR, kB}, {kR, kM}, {kM, kB}}}},
+    // 3: BL and BR (Bottom rectangle)
+    {2,
+     {{{kL, kB}, {kR, kB}, {kL, kM}},
+      {{kR, kB}, {kR, kM}, {kL, kM}}}},
+    // 4: TR
+    {1, {{{kR, kT}, {kM, kT}, {kR, kM}}}},
+    // 5: BL and TR
+    {2,
+     {{{kL, kB}, {kM, kB}, {kL, kM}},
+      {{kR, kT}, {kM, kT}, {kR, kM}}}},
+    // 6: BR and TR (Right rectangle)
+    {2,
+     {{{kM, kB}, {kR, kB}, {kM, kT}},
+      {{kR, kB}, {kR, kT}, {kM, kT}}}},
+    // 7: BL, BR, and TR
+    {3,
+     {{{kL, kB}, {kR, kB}, {kL, kM}},
+      {{kR, kB}, {kR, kT}, {kL, kM}},
+      {{kR, kT}, {kM, kT}, {kL, kM}}}},
+    // 8: TL
+    {1, {{{kL, kT}, {kL, kM}, {kM, kT}}}},
+    // 9: BL and TL (Left rectangle)
+    {2,
+     {{{kL, kB}, {kM, kB}, {kL, kT}},
+      {{kM, kB}, {kM, kT}, {kL, kT}}}},
+    // 10: BR and TL
+    {2,
+     {{{kR, kB}, {kR, kM}, {kM, kB}},
+      {{kL, kT}, {kL, kM}, {kM, kT}}}},
+    // 11: BL, BR, and TL
+    {3,
+     {{{kL, kB}, {kR, kB}, {kL, kT}},
+      {{kR, kB}, {kR, kM}, {kL, kT}},
+      {{kR, kM}, {kM, kT}, {kL, kT}}}},
+    // 12: TR and TL (Top rectangle)
+    {2,
+     {{{kL, kM}, {kR, kM}, {kL, kT}},
+      {{kR, kM}, {kR, kT}, {kL, kT}}}},
+    // 13: BL, TR, and TL
+    {3,
+     {{{kL, kB}, {kM, kB}, {kL, kT}},
+      {{kM, kB}, {kR, kM}, {kL, kT}},
+      {{kR, kM}, {kR, kT}, {kL, kT}}}},
+    // 14: BR, TR, and TL
+    {3,
+     {{{kM, kB}, {kR, kB}, {kL, kM}},
+      {{kR, kB}, {kR, kT}, {kL, kM}},
+      {{kR, kT}, {kL, kT}, {kL, kM}}}},
+    // 15: Full square
+    {2,
+     {{{kL, kB}, {kR, kB}, {kL, kT}},
+      {{kR, kB}, {kR, kT}, {kL, kT}}}},
+};
+
+constexpr Collider2D triangle(AEVec2 a, AEVec2 b, AEVec2 c) {
+    return {ColliderShape::Triangle, TriangleColliderData{{a, b, c}}};
+}
+
+constexpr Collider2D box(AEVec2 offset, AEVec2 size) {
+    return {ColliderShape::Box, BoxColliderData{offset, size}};
+}
+
+// Colliders of each case in local units, unused slots are Empty. Straight edges use one box
+// instead of two triangles.
+inline constexpr Collider2D kCaseColliders[16][3]{
+    // 0: Empty
+    {},
+    // 1: BL
+    {triangle({kL, kB}, {kM, kB}, {kL, kM})},
+    // 2: BR
+    {triangle({kR, kB}, {kR, kM}, {kM, kB})},
+    // 3: BL and BR (Bottom rectangle)
+    {box({0.0f, -0.25f}, {1.0f, 0.5f})},
+    // 4: TR
+    {triangle({kR, kT}, {kM, kT}, {kR, kM})},
+    // 5: BL and TR
+    {triangle({kL, kB}, {kM, kB}, {kL, kM}),
+     triangle({kR, kT}, {kM, kT}, {kR, kM})},
+    // 6: BR and TR (Right rectangle)
+    {box({0.25f, 0.0f}, {0.5f, 1.0f})},
+    // 7: BL, BR, and TR
+    {triangle({kL, kB}, {kR, kB}, {kL, kM}),
+     triangle({kR, kB}, {kR, kT}, {kL, kM}),
+     triangle({kR, kT}, {kM, kT}, {kL, kM})},
+    // 8: TL
+    {triangle({kL, kT}, {kL, kM}, {kM, kT})},
+    // 9: BL and TL (Left rectangle)
+    {box({-0.25f, 0.0f}, {0.5f, 1.0f})},
+    // 10: BR and TL
+    {triangle({kR, kB}, {kR, kM}, {kM, kB}),
+     triangle({kL, kT}, {kL, kM}, {kM, kT})},
+    // 11: BL, BR, and TL
+    {triangle({kL, kB}, {kR, kB}, {kL, kT}),
+     triangle({kR, kB}, {kR, kM}, {kL, kT}),
+     triangle({kR, kM}, {kM, kT}, {kL, kT})},
+    // 12: TR and TL (Top rectangle)
+    {box({0.0f, 0.25f}, {1.0f, 0.5f})},
+    // 13: BL, TR, and TL
+    {triangle({kL, kB}, {kM, kB}, {kL, kT}),
+     triangle({kM, kB}, {kR, kM}, {kL, kT}),
+     triangle({kR, kM}, {kR, kT}, {kL, kT})},
+    // 14: BR, TR, and TL
+    {triangle({kM, kB}, {kR, kB}, {kL, kM}),
+     triangle({kR, kB}, {kR, kT}, {kL, kM}),
+     triangle({kR, kT}, {kL, kT}, {kL, kM})},
+    // 15: Full square
+    {box({0.0f, 0.0f}, {1.0f, 1.0f})},
+};
+
+// Collider slots of one case, wrapped so a whole case can be returned from a constexpr function
+struct CaseColliders {
+    Collider2D slots_[3];
+};
+
+constexpr Collider2D meshTriangleCollider(u32 cellCase, u32 t) {
+    if (t >= kCaseTriangles[cellCase].count_)
+        return Collider2D{};
+
+    const AEVec2(&v)[3]{kCaseTriangles[cellCase].vertices_[t]};
+    return triangle(v[0], v[1], v[2]);
+}
+
+constexpr CaseColliders makeSmoothColliders(u32 cellCase) {
+    return {{meshTriangleCollider(cellCase, 0), meshTriangleCollider(cellCase, 1),
+             meshTriangleCollider(cellCase, 2)}};
+}
+
+// Colliders of interpolated cells: every render triangle is a collider, so the straight cases
+// become two triangles that can follow a sloped crossing. Midpoint vertices go through
+// placeVertex before use.
+inline constexpr CaseColliders kSmoothCaseColliders[16]{
+    makeSmoothColliders(0),  makeSmoothColliders(1),  makeSmoothColliders(2),
+    makeSmoothColliders(3),  makeSmoothColliders(4),  makeSmoothColliders(5),
+    makeSmoothColliders(6),  makeSmoothColliders(7),  makeSmoothColliders(8),
+    makeSmoothColliders(9),  makeSmoothColliders(10), makeSmoothColliders(11),
+    makeSmoothColliders(12), makeSmoothColliders(13), makeSmoothColliders(14),
+    makeSmoothColliders(15),
+};
+
+// =========================================================
+// Compile-time consistency checks
+// =========================================================
+
+// Twice the signed area of the triangle abc
+constexpr f32 cross(const AEVec2& a, const AEVec2& b, const AEVec2& c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+constexpr f32 absolute(f32 value) { return value < 0.0f ? -value : value; }
+
+constexpr bool pointInTriangle(const AEVec2 (&vertices)[3], const AEVec2& p) {
+    const f32 d0{cross(vertices[0], vertices[1], p)};
+    const f32 d1{cross(vertices[1], vertices[2], p)};
+    const f32 d2{cross(vertices[2], vertices[0], p)};
+    const bool hasNegative{d0 < 0.0f || d1 < 0.0f || d2 < 0.0f};
+    const bool hasPositive{d0 > 0.0f || d1 > 0.0f || d2 > 0.0f};
+    return !(hasNegative && hasPositive);
+}
+
+constexpr bool meshCovers(u32 cellCase, const AEVec2& p) {
+    for (u32 t{0}; t < kCaseTriangles[cellCase].count_; ++t) {
+        if (pointInTriangle(kCaseTriangles[cellCase].vertices_[t], p))
+            return true;
+    }
+    return false;
+}
+
+constexpr bool collidersCover(const Collider2D (&colliders)[3], const AEVec2& p) {
+    for (const Collider2D& collider : colliders) {
+        if (collider.colliderShape_ == ColliderShape::Triangle &&
+            pointInTriangle(collider.shapeData_.triangle_.vertices_, p))
+            return true;
+
+        if (collider.colliderShape_ == ColliderShape::Box) {
+            const BoxColliderData& box{collider.shapeData_.box_};
+            if (absolute(p.x - box.offset_.x) <= box.size_.x * 0.5f &&
+                absolute(p.y - box.offset_.y) <= box.size_.y * 0.5f)
+                return true;
+        }
+    }
+    return false;
+}
+
+constexpr f32 meshArea(u32 cellCase) {
+    f32 area{0.0f};
+    for (u32 t{0}; t < kCaseTriangles[cellCase].count_; ++t) {
+        const AEVec2(&v)[3]{kCaseTriangles[cellCase].vertices_[t]};
+        area += absolute(cross(v[0], v[1], v[2])) * 0.5f;
+    }
+    return area;
+}
+
+constexpr f32 collidersArea(const Collider2D (&colliders)[3]) {
+    f32 area{0.0f};
+    for (const Collider2D& collider : colliders) {
+        if (collider.colliderShape_ == ColliderShape::Triangle) {
+            const AEVec2(&v)[3]{collider.shapeData_.triangle_.vertices_};
+            area += absolute(cross(v[0], v[1], v[2])) * 0.5f;
+        } else if (collider.colliderShape_ == ColliderShape::Box) {
+            area += collider.shapeData_.box_.size_.x * collider.shapeData_.box_.size_.y;
+        }
+    }
+    return area;
+}
+
+// True if a case's mesh and the given colliders cover the same area and the same sample points,
+// and a point near each corner is covered exactly when that corner's bit is set. The samples sit
+// on a 6x6 lattice that never lands on an edge of either table.
+constexpr bool isCaseConsistent(u32 cellCase, const Collider2D (&colliders)[3]) {
+    if (meshArea(cellCase) != collidersArea(colliders))
+        return false;
+
+    for (u32 i{0}; i < 6; ++i) {
+        for (u32 j{0}; j < 6; ++j) {
+            const AEVec2 p{-0.45f + 0.18f * i, -0.45f + 0.18f * j};
+            if (meshCovers(cellCase, p) != collidersCover(colliders, p))
+                return false;
+        }
+    }
+
+    constexpr AEVec2 kCornerSamples[4]{{-0.45f, -0.45f}, {0.45f, -0.45f}, {0.45f, 0.45f},
+                                       {-0.45f, 0.45f}}; // BL=1, BR=2, TR=4, TL=8
+    for (u32 corner{0}; corner < 4; ++corner) {
+        const bool filled{(cellCase >> corner & 1u) != 0};
+        if (meshCovers(cellCase, kCornerSamples[corner]) != filled)
+            return false;
+    }
+    return true;
+}
+
+constexpr bool areTablesConsistent() {
+    for (u32 cellCase{0}; cellCase < 16; ++cellCase) {
+        if (!isCaseConsistent(cellCase, kCaseColliders[cellCase]) ||
+            !isCaseConsistent(cellCase, kSmoothCaseColliders[cellCase].slots_))
+            return false;
+    }
+    return true;
+}
+
+static_assert(areTablesConsistent(),
+              "Marching-squares mesh triangles and colliders disagree for at least one case");
+static_assert(meshArea(0) == 0.0f && meshArea(15) == 1.0f,
+              "Case 0 must be empty and case 15 must fill the whole cell");
+} // namespace MarchingSquares
@@ -34,6 +34,7 @@
 // Project
 #include "Components.h"
 #include "FluidSystem.h"
+#include "TriggerRegistry.h"
 #include "VFXSystem.h"
 
 // Forward declarations
@@ -55,6 +56,7 @@ enum class MossType {
 // ==========================================
 struct Moss {
     Transform transform_;
+    WorldMtxCache worldCache_; // Inputs transform_.worldMtx_ was last composed from
     Collider2D collider_;
 
     MossType type_; // Always Spiky
@@ -71,7 +73,7 @@ struct Moss {
 // ==========================================
 // MOSS SYSTEM
 // ==========================================
-class MossSystem {
+class MossSystem : public ITriggerListener {
 private:
     // Procedural colour meshes (fallback when texture is missing)
     AEGfxVertexList* spikyMossMesh_{nullptr};
@@ -101,13 +103,18 @@ private:
 
     float globalTimer_{0.0f};
 
+    f32 mossHitVfxCooldown_{0.0f};  // Seconds until the next hit VFX may spawn
+    VFXSystem* vfxSystem_{nullptr}; // Target of the VFX spawned by this frame's trigger hits
+
 public:
     void load(s8 font);
     void unload();
     void initialize();
     void loadLevelMoss(AEVec2 pos, MossType type);
-    void update(f32 dt, std::vector<FluidParticle>& particlePool,
-                StartEndPoint& startEndPointSystem, VFXSystem& vfx);
+    void update(f32 dt, FluidSystem& fluidSystem, StartEndPoint& startEndPointSystem,
+                VFXSystem& vfx);
+    void onTriggerHits(u32 tag, const std::vector<u32>& particleIndices,
+                       TriggerRegistry& registry, FluidSystem& fluidSystem) override;
     void draw();
     void drawPreview();
     void free();
@@ -115,10 +122,14 @@ public:
     void spawnAtMousePos();
     void destroyAtMousePos();
 
+    // Debug stress test: lays a grid of moss (sized in moss.json) over the given world area,
+    // leaving out the slots that sit on solid terrain. Returns the number of moss placed.
+    int spawnStressGrid(const AEVec2& bottomLeft, f32 areaWidth, f32 areaHeight,
+                        const Terrain& terrain);
+
     std::vector<Moss>& getMosses() { return mosses_; }
 
 private:
     void createMeshes();
-    bool checkCollisionWithWater(const Moss& moss, const FluidParticle& particle);
     void drawMoss(const Moss& m);
 };
\ No newline at end of file
@@ -31,6 +31,7 @@
 // =============================
 #include "Components.h"
 #include "FluidSystem.h"
+#include "TriggerRegistry.h"
 #include "VFXSystem.h"
 
 // ==========================================
@@ -42,7 +43,12 @@ struct Portal {
 
     Collider2D collider_;
 
-    Portal* linkedPortal_{nullptr};
+    s32 linkedIndex_{-1}; // Index of the paired portal in the pool, -1 while unlinked
+
+    // Cached at placement, portals never move or rotate once placed
+    f32 cosRotation_{1.0f};
+    f32 sinRotation_{0.0f};
+    AEVec2 halfExtents_{}; // Half of the collider box
 
     f32 red_{};
     f32 green_{};
@@ -52,16 +58,39 @@ struct Portal {
     Portal(AEVec2 pos, AEVec2 scale, f32 rotationDeg);
 };
 
+// ==========================================
+// Portal Transit
+// ==========================================
+// Entry to exit mapping of a linked portal, rebuilt once per frame so teleporting a particle needs
+// no trig. A portal's face is its local y axis, particles leave along its local x axis.
+struct PortalTransit {
+    AEVec2 entryPos_{};
+    AEVec2 entryFaceAxis_{0.0f, 1.0f};
+    f32 faceScale_{1.0f}; // Exit face length over entry face length
+    f32 exitHalfFace_{0.0f};
+
+    AEVec2 exitPos_{};
+    AEVec2 exitDirection_{1.0f, 0.0f}; // Unit vector the particle leaves the exit portal along
+    AEVec2 exitFaceAxis_{0.0f, 1.0f};
+};
+
+// A particle entering a portal this frame, waiting to be placed at the exit
+struct PortalTeleport {
+    u32 particleIndex_{0};
+    f32 faceOffset_{0.0f}; // Position along the exit face, from the centre
+};
+
 // ==========================================
 // Portal System
 // ==========================================
-class PortalSystem {
+class PortalSystem : public ITriggerListener {
 private:
     AEGfxVertexList* rectMesh_ = nullptr;
 
-    // Can have multiple portals
-    std::vector<Portal*> portalVec_;
-    Portal* currentPortal_{nullptr};
+    // Can have multiple portals. Stored by value in placement order and linked by index, so the
+    // trigger pass walks contiguous memory and copying the vector snapshots every portal.
+    std::vector<Portal> portals_;
+    s32 currentPortal_{-1}; // Unlinked portal waiting for its pair, -1 if none
 
     // Graphic configs for each portal
     Graphics portalGraphicsConfigs_;
@@ -77,12 +106,29 @@ private:
     int portalLimit_{};
     f32 portalVfxCooldown_{0.0f};
 
+    VFXSystem* vfxSystem_{nullptr}; // Target of the VFX spawned by this frame's trigger hits
+    std::vector<PortalTransit> transits_; // Per portal in portals_, valid for linked portals
+    std::vector<PortalTeleport> teleportBatch_; // Scratch buffer for one portal's entrants
+
+    // Gap between particles placed at an exit, as a multiple of the particle diameter
+    f32 exitSpacing_{1.0f};
+
+    static PortalTransit buildTransit(const Portal& entry, const Portal& exit);
+
+    // Spreads one row of sorted face offsets over the exit face at least spacing apart
+    static void spreadExitRow(PortalTeleport* row, size_t count, f32 spacing, f32 halfFace);
+
+    // Unlinks and erases a portal, fixing up the indices of the portals after it
+    void removePortal(s32 index);
+
 public:
     // ==========================================
     // Lifecycle
     // ==========================================
     void initialize(int const& portalMax = 0);
-    void update(f32 dt, std::vector<FluidParticle>& particlePool, VFXSystem& vfx);
+    void update(f32 dt, FluidSystem& fluidSystem, VFXSystem& vfx);
+    void onTriggerHits(u32 tag, const std::vector<u32>& particleIndices,
+                       TriggerRegistry& registry, FluidSystem& fluidSystem) override;
     void draw();
     void free();
 
@@ -96,16 +142,11 @@ public:
     void checkMouseClick();
     void resetIframe();
 
-    // ==========================================
-    // Simulation
-    // ==========================================
-    bool collisionCheckWithWater(Portal portal, FluidParticle particle);
-
     // ==========================================
     // Getters
     // ==========================================
     f32 getRotationValue() const;
-    const std::vector<Portal*>& getPortals() const;
+    const std::vector<Portal>& getPortals() const;
     int getPortalLimit() const;
     int getPortalCount() const;
 };
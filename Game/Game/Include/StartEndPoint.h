@@ -31,6 +31,7 @@
 // =============================
 #include "Components.h"
 #include "FluidSystem.h"
+#include "TriggerRegistry.h"
 #include "VFXSystem.h"
 
 // =============================
@@ -43,9 +44,25 @@ enum class StartEndType { Pipe, Flower, Count };
 // =============================
 enum class GoalDirection { Up, Down, Left, Right };
 
+// =============================
+// Pipe Emission Schedule
+// =============================
+// How the pipes of a StartEndPoint emit water, shared by all of its pipes.
+struct PipeSchedule {
+    f32 spawnInterval_{0.025f}; // Seconds between two particles of a pipe
+    f32 particleRadius_{10.0f};
+    s32 burstCount_{0};      // Particles per burst, 0 for a continuous stream
+    f32 burstPause_{0.0f};   // Seconds a pipe rests after each burst
+    f32 startDelay_{0.0f};   // Seconds a pipe rests before its first particle
+    f32 vfxInterval_{0.12f}; // Seconds between pipe-flow VFX bursts while emitting
+};
+
 struct StartEnd {
 
     f32 vfxTimer_ = 0.0f;
+    f32 spawnTimer_ = 0.0f; // Seconds until the pipe's next particle
+    s32 burstSpawned_ = 0;  // Particles emitted in the current burst
+    bool resting_ = false;  // Between bursts, or waiting out the start delay
 
     Transform transform_;
     Collider2D collider_;
@@ -65,7 +82,7 @@ struct StartEnd {
     StartEnd(AEVec2 pos, AEVec2 scale, f32 rotation, StartEndType type, GoalDirection direction);
 };
 
-class StartEndPoint {
+class StartEndPoint : public ITriggerListener {
 private:
     AEGfxVertexList* rectMesh_ = nullptr;
     AEGfxVertexList* flowerMesh_ = nullptr;
@@ -77,6 +94,29 @@ private:
     AEGfxVertexList* barMesh_{nullptr};
     s8 font_{0};
 
+    VFXSystem* vfxSystem_{nullptr}; // Target of the VFX spawned by this frame's trigger hits
+
+    PipeSchedule pipeSchedule_;
+
+    // Goal collection feedback, emitted once per pass for the whole batch collected
+    f32 collectVolume_{0.4f};             // Volume for a single particle
+    f32 collectVolumePerParticle_{0.02f}; // Added for every further particle in the batch
+    f32 collectVolumeMax_{0.8f};
+    f32 collectVfxScaleMax_{4.0f}; // Cap on the FlowerCollect burst size multiplier
+
+    // Half of the collider box, the extents trigger boxes take
+    static AEVec2 getHalfExtents(const StartEnd& startEnd) {
+        return AEVec2{startEnd.collider_.shapeData_.box_.size_.x / 2.0f,
+                      startEnd.collider_.shapeData_.box_.size_.y / 2.0f};
+    }
+
+    // Advances one pipe's emission schedule, spawning its particle and flow VFX when due
+    void updatePipe(StartEnd& pipe, s32 pipeIndex, f32 dt, FluidSystem& fluidSystem,
+                    VFXSystem& vfxSystem);
+
+    // Spends one particle's worth of the pipe's water and spawns it at the pipe mouth
+    void emitParticle(StartEnd& pipe, s32 pipeIndex, FluidSystem& fluidSystem);
+
 public:
     // Can have multiple start points but only one end point
     std::vector<StartEnd> startPoints_;
@@ -85,6 +125,9 @@ public:
 
     s32 particlesCollected_{0};
 
+    // Water a pipe spends per emitted particle, and gets back when that particle is culled
+    f32 waterPerParticle_{0.5f};
+
     // ==========================================
     // Lifecycle
     // ==========================================
@@ -100,12 +143,15 @@ public:
     void spawnAtMousePos(StartEndType type, GoalDirection direction);
     void deleteAtMousePos();
 
+    // Replaces the pipes' emission schedule and restarts every pipe on it
+    void setPipeSchedule(const PipeSchedule& schedule);
+
     // ==========================================
     // Simulation
     // ==========================================
-    bool collisionCheckWithWater(StartEnd startend, FluidParticle particle);
-
-    void update(f32 dt, std::vector<FluidParticle>& particlePool, VFXSystem& vfxSystem);
+    void update(f32 dt, FluidSystem& fluidSystem, VFXSystem& vfxSystem);
+    void onTriggerHits(u32 tag, const std::vector<u32>& particleIndices,
+                       TriggerRegistry& registry, FluidSystem& fluidSystem) override;
 
     // ==========================================
     // Rendering
@@ -133,4 +179,5 @@ public:
     void setWaterRemaining(int startPointIndex, float amount);
     void refillAllWater();
     void toggleInfiniteWater();
+    void refundCulledWater(FluidSystem& fluidSystem);
 };
\ No newline at end of file
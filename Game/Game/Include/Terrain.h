@@ -6,8 +6,15 @@
 @date		March, 31, 2026
 
 @brief      This header file  contains the declarations of the Terrain class,
-            which manages a marching-squares grid of cells with shared mesh and collider
-            libraries for node-based terrain editing and rendering.
+            which manages a marching-squares grid of cells with compile-time mesh and
+            collider tables for node-based terrain editing and rendering. Every material lives
+            in one grid as a bit plane per material, and each cell is stored as its
+            1-byte solid case index; meshes, colliders and matrices are derived on
+            demand. The grid is split into 32x32 chunks that are only allocated once
+            they hold terrain, so empty parts of large maps cost nothing, and each
+            chunk is drawn from one baked mesh per material. With node densities
+            enabled the surface is interpolated between nodes, so edges are no
+            longer limited to 45 degree steps.
 
 @copyright  Copyright (C) 2026 DigiPen Institute of Technology.
             Reproduction or disclosure of this file or its contents
@@ -17,6 +24,7 @@
 #pragma once
 
 // Standard library
+#include <memory>
 #include <random>
 #include <vector>
 
@@ -25,42 +33,120 @@
 
 // Project
 #include "Components.h"
+#include "MarchingSquares.h"
+#include "TerrainMeshBuilder.h"
 
 enum class TerrainMaterial { Dirt, Stone, Magic };
 
-class Cell {
+constexpr u32 kTerrainMaterialCount{3};
+
+// Side length of a terrain chunk, in both cells and nodes
+constexpr u32 kTerrainChunkSize{32};
+
+// View of a single terrain cell, derived on demand from its case index. Cells never rotate, so a
+// centre and a side length are enough to place the case table colliders in world space.
+struct Cell {
+    AEVec2 pos_{0.0f, 0.0f};                // World position of the cell's centre
+    f32 size_{0.0f};                        // Side length in world units
+    const Collider2D* colliders_{nullptr}; // 3 slots in one of the MarchingSquares tables
+    MarchingSquares::CellEdges edges_{};    // Apply with placeVertex to the triangle vertices
+};
+
+// Inclusive rectangle of grid indices, used for both node and cell ranges
+struct GridRegion {
+    u32 minRow_{0};
+    u32 minCol_{0};
+    u32 maxRow_{0};
+    u32 maxCol_{0};
+};
+
+// Edit counters of one frame, shown by the debug overlay
+struct TerrainEditStats {
+    u32 editsQueued_ = 0;      // Brush stamps whose rebuild was deferred to commitEdits
+    u32 rebuilds_ = 0;         // Rebuild passes run by commitEdits
+    u32 cellsRebuilt_ = 0;     // Cells reclassified by those passes
+    f32 rebuildTimeMs_ = 0.0f; // Total time spent in those passes
+};
+
+// One bit per node. Rows are padded to whole 64-bit words so a full row of cells can be classified
+// with word-level bit operations.
+class NodeBitPlane {
 public:
-    Transform transform_;
-    Graphics graphics_;
-    Collider2D colliders_[3];
+    void resize(u32 rows, u32 cols);
+
+    bool get(u32 row, u32 col) const {
+        return (words_[static_cast<size_t>(row) * wordsPerRow_ + (col >> 6)] >> (col & 63)) & 1u;
+    }
+
+    void set(u32 row, u32 col, bool value);
+
+    // Word w of a row holds the nodes [64w, 64w + 63], bit i being node 64w + i
+    u64 getWord(u32 row, u32 word) const {
+        return words_[static_cast<size_t>(row) * wordsPerRow_ + word];
+    }
+
+    u32 getWordsPerRow() const { return wordsPerRow_; }
 
 private:
+    u32 wordsPerRow_{0};
+    std::vector<u64> words_;
+};
+
+// The nodes and cells of a 32x32 block of the grid. A chunk owns the nodes and the cells whose
+// bottom-left corner falls inside it; the nodes on its top and right edges belong to neighbours.
+struct TerrainChunk {
+    NodeBitPlane planes_[kTerrainMaterialCount]; // One bit plane per material
+    std::vector<u8> density_;                    // Per node, only when densities are enabled
+    std::vector<MarchingSquares::CellEdges> cellEdges_; // Solid crossings per cell, likewise
+    u8 cellCases_[kTerrainChunkSize * kTerrainChunkSize]{}; // Solid marching-squares cases
+
+    AEGfxVertexList* meshes_[kTerrainMaterialCount]{}; // Baked render batch per material
+    bool meshDirty_{true};                             // Meshes must be rebaked before drawing
 };
 
+// A single grid holding every terrain material. Each material is a bit plane and a node is set in
+// at most one of them, the solid materials (dirt and stone) share one collider field and each
+// material is drawn as its own batch. An optional 8-bit density per node moves the surface along
+// each cell edge, for both the meshes and the colliders. Storage is split into chunks that are
+// created on the first edit inside them.
 class Terrain {
 public:
-    Terrain(TerrainMaterial terrainMaterial, AEGfxTexture* pTex, AEVec2 centerPosition,
-            u32 cellRows, u32 cellCols, u32 cellSize, bool collidable);
+    Terrain(AEVec2 centerPosition, u32 cellRows, u32 cellCols, u32 cellSize);
 
-    void initCellsTransform();
+    ~Terrain();
 
-    void initCellsGraphics();
+    void setTexture(TerrainMaterial material, AEGfxTexture* pTex);
 
-    void initCellsCollider();
+    // Derives every cell's marching-squares case from the nodes (call after loading the nodes)
+    void initCells();
 
-    void updateTerrain();
+    // Brush edits write their nodes (and meshes) right away but only queue the cell rebuild. The
+    // queued regions are merged and rebuilt in one pass by commitEdits, which must run before the
+    // cells are read for collision.
 
-    bool destroyAtMouse(f32 radius);
+    // Removes only nodes of the given material. Returns true if any node was changed.
+    bool destroyAtMouse(TerrainMaterial material, f32 radius);
 
-    void buildAtMouse(f32 radius);
+    void buildAtMouse(TerrainMaterial material, f32 radius);
 
-    void renderTerrain();
+    // Clears every node of the material within radius of the segment from-to (a capsule). Returns
+    // true if any node was changed.
+    bool destroyStroke(TerrainMaterial material, const AEVec2& from, const AEVec2& to, f32 radius);
+
+    // Fills every node within radius of the segment from-to (a capsule). Nodes of a higher
+    // priority material are kept (Stone > Dirt > Magic).
+    void buildStroke(TerrainMaterial material, const AEVec2& from, const AEVec2& to, f32 radius);
 
-    static void createMeshLibrary();
+    // Rebuilds the cells around every edit queued since the last commit in a single pass
+    void commitEdits();
 
-    static void freeMeshLibrary();
+    bool hasPendingEdits() const { return hasPendingEdits_; }
 
-    static void createColliderLibrary();
+    const TerrainEditStats& getEditStats() const { return editStats_; }
+
+    void resetEditStats() { editStats_ = TerrainEditStats{}; }
+
+    void renderTerrain();
 
     u32 getCellRows() const { return kCellRows_; }
 
@@ -70,23 +156,73 @@ public:
 
     AEVec2 getBottomLeftPos() const { return bottomLeftPos_; }
 
-    std::vector<Cell>& getCells() { return cells_; }
+    size_t getCellCount() const { return static_cast<size_t>(kCellRows_) * kCellCols_; }
 
-    std::vector<f32>& getNodes() { return nodes_; }
+    size_t getNodeCount() const { return static_cast<size_t>(kNodeRows_) * kNodeCols_; }
 
-    std::vector<bool>& getCachedHasColliders() { return cachedHasColliders_; }
-    bool isCollidersCacheDirty() const { return collidersCacheDirty_; }
-    void markCollidersCacheDirty() { collidersCacheDirty_ = true; }
-    void markCollidersCacheClean() { collidersCacheDirty_ = false; }
+    // Bytes held by the per-cell store (cases, plus edge crossings with densities enabled) of the
+    // allocated chunks, for the debug HUD
+    size_t getCellStorageBytes() const;
 
-    bool isNearestNodeToMouseAtThreshold();
+    // Time the last initCells took to classify every cell, for the debug HUD
+    f32 getInitCellsTimeMs() const { return initCellsTimeMs_; }
 
-private:
-    TerrainMaterial terrainMaterial_;
+    // Changes on every initCells, unique across all terrains, so cached contacts can tell a
+    // re-initialised (or re-created) terrain from the one they were made against
+    u32 getGeneration() const { return generation_; }
+
+    Cell getCell(size_t cellIndex) const;
+
+    // True if the cell has at least one non-Empty collider
+    bool cellHasColliders(size_t cellIndex) const;
+
+    u32 getChunkRows() const { return kChunkRows_; }
+
+    u32 getChunkCols() const { return kChunkCols_; }
+
+    // True if the chunk holds storage, unallocated chunks have no terrain at all
+    bool isChunkAllocated(u32 chunkRow, u32 chunkCol) const {
+        return chunks_[static_cast<size_t>(chunkRow) * kChunkCols_ + chunkCol] != nullptr;
+    }
 
+    // Inclusive range of cells covered by a chunk, clamped to the grid (it may be empty)
+    GridRegion getChunkCellRegion(u32 chunkRow, u32 chunkCol) const;
+
+    // Expands one material into the per-layer float format of level files (1.0 = filled)
+    std::vector<f32> getMaterialNodes(TerrainMaterial material) const;
+
+    // Merges a per-layer float array (>= 1.0 = filled) into the grid. Overlaps keep the higher
+    // priority material.
+    void setMaterialNodes(TerrainMaterial material, const std::vector<f32>& layerNodes);
+
+    bool isNearestNodeToMouseMaterial(TerrainMaterial material);
+
+    // True if the node nearest to a world position holds a material that fluid collides with
+    bool isSolidAt(const AEVec2& worldPos) const;
+
+    // Keeps an 8-bit density per node next to the bit planes (filled at or above 128). Enabling
+    // seeds the densities from the current bits; brush edits then write a soft rim. The meshes and
+    // colliders place each edge vertex where the densities cross 128 instead of at the midpoint,
+    // so larger cells still give smooth slopes.
+    void setDensityEnabled(bool enabled);
+
+    bool isDensityEnabled() const { return densityEnabled_; }
+
+    // Density of a node, 0 or 255 when densities are disabled
+    u8 getNodeDensity(u32 row, u32 col) const;
+
+    // Every node's density in row-major order (one byte per node), the layer stored in level files
+    std::vector<u8> getNodeDensities() const;
+
+    // Restores a saved density layer. Each density is clamped to its node's filled state, so the
+    // layer can only move edges, never fill or empty a node. Ignored while densities are disabled;
+    // call initCells afterwards.
+    void setNodeDensities(const std::vector<u8>& densities);
+
+private:
     Transform transform_; // Position represents the centre of the terrain
 
-    Graphics graphics_; // Only for AEGfxTexture* texture_
+    AEGfxTexture* textures_[kTerrainMaterialCount]{}; // Spritesheet atlas per material
 
     const u32 kCellRows_;
     const u32 kCellCols_;
@@ -95,14 +231,19 @@ private:
     const u32 kNodeRows_;
     const u32 kNodeCols_;
 
-    std::vector<f32> nodes_;
-    std::vector<Cell> cells_;
+    const u32 kChunkRows_;
+    const u32 kChunkCols_;
+
+    std::vector<std::unique_ptr<TerrainChunk>> chunks_; // Row-major, nullptr while empty
+    bool densityEnabled_{false};
 
-    f32 threshold_{1.0f};
+    std::vector<TerrainVertex> bakeVertices_; // Scratch buffer reused by every mesh bake
 
-    static AEGfxVertexList* meshLibrary_[16];  // There are 16 possible meshes
-    static Collider2D colliderLibrary_[16][3]; // There are 16 possible colliders, [3] as each cell
-                                               // uses 1, 2, or 3 colliders
+    GridRegion pendingNodes_{};   // Bounding region of the nodes edited since the last commit
+    bool hasPendingEdits_{false}; // pendingNodes_ is only meaningful while this is set
+    TerrainEditStats editStats_{};
+    f32 initCellsTimeMs_{0.0f};
+    u32 generation_{0};
 
     f32 halfWidth_;
     f32 halfHeight_;
@@ -110,15 +251,70 @@ private:
 
     void destroyTerrain(f32 worldX, f32 worldY);
 
-    bool destroyTerrainRadius(f32 worldX, f32 worldY, f32 radius);
+    // Builds or clears the material within radius of the segment from-to. Returns true if any
+    // node changed.
+    bool stampCapsule(TerrainMaterial material, const AEVec2& from, const AEVec2& to, f32 radius,
+                      bool build);
+
+    // Returns where this frame's mouse stroke starts: last frame's cursor if the same material and
+    // action were stroked on the previous frame
+    AEVec2 continueStroke(const AEVec2& cursor, TerrainMaterial material, bool build);
 
-    void buildTerrainRadius(f32 worldX, f32 worldY, f32 radius);
+    // Chunk by chunk coordinate, nullptr if unallocated or outside the grid
+    TerrainChunk* getChunk(u32 chunkRow, u32 chunkCol) const;
 
-    bool collidable_;
+    // Allocates the chunk owning a node if needed, along with the neighbours whose cells use the
+    // node as a corner
+    TerrainChunk& touchChunksForNode(u32 row, u32 col);
+
+    // Flags the meshes of every chunk with a cell using the node as a corner for a rebake
+    void markChunksDirtyForNode(u32 row, u32 col);
+
+    // Rebuilds a chunk's per-material meshes from its current cases
+    void bakeChunkMeshes(u32 chunkRow, u32 chunkCol, TerrainChunk& chunk);
+
+    // Material bit of a node (see kMaterialBits), 0 when empty
+    u8 getNode(u32 row, u32 col) const;
+
+    // Moves a node to the material with the given bit, or empties it when bit is 0
+    void setNode(u32 row, u32 col, u8 bit);
+
+    // Row of a chunk's nodes that are set in any of the planes selected by materialMask
+    static u64 getMaskedWord(const TerrainChunk* chunk, u32 localRow, u8 materialMask);
+
+    // 4-bit marching-squares case of a cell (TL=8, TR=4, BR=2, BL=1) over the nodes whose material
+    // bit is in materialMask
+    u8 computeCellCase(u32 row, u32 col, u8 materialMask) const;
+
+    // Density of a node as seen by the materials in materialMask: nodes of other materials read as
+    // the inverse of their density. Always at least 128 inside the mask and below it outside.
+    u8 getMaskedDensity(u32 row, u32 col, u8 materialMask) const;
+
+    // Interpolated crossings of a cell's edges over the materials in materialMask
+    MarchingSquares::CellEdges computeCellEdges(u32 row, u32 col, u8 materialMask) const;
+
+    // Writes the cases of one row of a chunk's cells using word-level bit operations
+    void classifyChunkRow(u32 chunkRow, u32 chunkCol, u32 localRow, u8 materialMask,
+                          u8* outCases) const;
+
+    // Clamped range of nodes inside the capsule's bounding box. False if it misses the grid.
+    bool getNodeRegionInCapsule(const AEVec2& from, const AEVec2& to, f32 radius,
+                                GridRegion& outNodes) const;
+
+    // Recomputes the case of every cell sharing a node in the region
+    void rebuildCellsAroundNodes(const GridRegion& nodes);
+
+    // Grows the pending region to cover the edited nodes, the rebuild waits for commitEdits
+    void queueRebuild(const GridRegion& nodes);
 
     static AEGfxVertexList* debugTriMesh_;
     static AEGfxVertexList* debugBoxMesh_;
-
-    std::vector<bool> cachedHasColliders_;
-    bool collidersCacheDirty_ = true;
+    static u32 nextGeneration_;
+
+    // Mouse stroke continuity, so fast drags carve a continuous tunnel instead of separate dots
+    bool strokeActive_{false};
+    u32 lastStrokeFrame_{0};
+    TerrainMaterial lastStrokeMaterial_{TerrainMaterial::Dirt};
+    bool lastStrokeBuild_{false};
+    AEVec2 lastStrokePos_{0.0f, 0.0f};
 };
@@ -0,0 +1,56 @@
+/*!
+@file       TerrainMeshBuilder.h
+@author     Sean Lee Hong Wei/seanhongwei.lee@digipen.edu
+@co_author  Woo Guang Theng/guangtheng.woo@digipen.edu
+
+@date		March, 31, 2026
+
+@brief      This header file contains the declarations of the CPU-side terrain
+            mesh builder, which turns marching-squares cell cases into world
+            space triangles with the spritesheet atlas UVs already applied.
+            It makes no graphics calls, so it can run without a window.
+
+@copyright  Copyright (C) 2026 DigiPen Institute of Technology.
+            Reproduction or disclosure of this file or its contents
+            without the prior written consent of DigiPen Institute of
+            Technology is prohibited.
+*//*______________________________________________________________________*/
+#pragma once
+
+// Standard library
+#include <vector>
+
+// Third-party
+// Only the plain math types, so the builder links without the engine or a window
+#include <AETypes.h>
+#include <AEVec2.h>
+
+namespace MarchingSquares {
+struct CellEdges;
+}
+
+// One vertex of a baked terrain mesh, every three vertices form a triangle
+struct TerrainVertex {
+    f32 x_{0.0f}; // World position
+    f32 y_{0.0f};
+    f32 u_{0.0f}; // Atlas texture coordinate
+    f32 v_{0.0f};
+};
+
+class TerrainMeshBuilder {
+public:
+    // Number of triangles in a marching-squares case (0-3)
+    static u32 getTriangleCount(u8 cellCase);
+
+    // Appends the triangles of the cell at (row, col) of a grid whose bottom-left corner is at
+    // gridBottomLeft. Case 0 appends nothing. Without edges the surface crosses the edge midpoints.
+    static void appendCell(std::vector<TerrainVertex>& vertices, u8 cellCase, u32 row, u32 col,
+                           f32 cellSize, const AEVec2& gridBottomLeft,
+                           const MarchingSquares::CellEdges* edges = nullptr);
+
+    // Appends a run of count cells of one row, starting at firstCol. cellEdges is either nullptr
+    // or holds one entry per cell.
+    static void appendRow(std::vector<TerrainVertex>& vertices, const u8* cellCases, u32 count,
+                          u32 row, u32 firstCol, f32 cellSize, const AEVec2& gridBottomLeft,
+                          const MarchingSquares::CellEdges* cellEdges = nullptr);
+};
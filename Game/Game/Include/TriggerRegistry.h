@@ -0,0 +1,130 @@
+/*!
+@file       TriggerRegistry.h
+@author     Sean Lee Hong Wei/seanhongwei.lee@digipen.edu
+@co_author  Woo Guang Theng/guangtheng.woo@digipen.edu,
+            Chia Hanxin/c.hanxin@digipen.edu
+
+@date		March, 31, 2026
+
+@brief      This header file contains the declarations of the trigger volume
+            registry shared by the gameplay systems which includes the following:
+
+                - ITriggerListener, the callback interface a gameplay system
+                  implements to react to the particles inside its volumes.
+                - TriggerVolume, a circle or oriented box registered by a
+                  gameplay system for the current frame.
+                - TriggerRegistry, which buckets the frame's volumes into the
+                  fluid grid and tests every water particle against them in a
+                  single pass, then dispatches the hits to their listeners.
+
+@copyright  Copyright (C) 2026 DigiPen Institute of Technology.
+            Reproduction or disclosure of this file or its contents
+            without the prior written consent of DigiPen Institute of
+            Technology is prohibited.
+*//*______________________________________________________________________*/
+#pragma once
+// ==========================================
+//              Includes
+// ==========================================
+
+// Standard library
+#include <utility>
+#include <vector>
+
+// Third-party
+#include <AEEngine.h>
+
+// Project
+#include "CollisionContext.h"
+
+class FluidSystem;
+class TriggerRegistry;
+
+// ==========================================
+//              ITriggerListener
+// ==========================================
+// Implemented by the gameplay systems that own trigger volumes.
+class ITriggerListener {
+public:
+    virtual ~ITriggerListener() = default;
+
+    // Called once per volume that water touched this pass. particleIndices are the water pool
+    // indices inside the volume in ascending order, without the particles an earlier volume
+    // consumed. The pool is not modified until every listener has run.
+    virtual void onTriggerHits(u32 tag, const std::vector<u32>& particleIndices,
+                               TriggerRegistry& registry, FluidSystem& fluidSystem) = 0;
+};
+
+// ==========================================
+//              TriggerVolume
+// ==========================================
+enum class TriggerShape { Circle, OrientedBox };
+
+struct TriggerVolume {
+    TriggerSystem system_{TriggerSystem::Portal}; // Owning system, for the trigger stats
+    TriggerShape shape_{TriggerShape::Circle};
+    AEVec2 center_{0.0f, 0.0f};
+    f32 radius_{0.0f};               // Circle only
+    AEVec2 halfExtents_{0.0f, 0.0f}; // OrientedBox only
+    f32 cosAngle_{1.0f};             // Inverse rotation of an OrientedBox
+    f32 sinAngle_{0.0f};
+    AEVec2 boundsMin_{0.0f, 0.0f}; // World bounding box of the shape
+    AEVec2 boundsMax_{0.0f, 0.0f};
+
+    ITriggerListener* listener_{nullptr}; // nullptr volumes are only counted in the stats
+    u32 tag_{0};                          // Passed back to the listener, e.g. an object index
+
+    // True if a particle collider at pos with the given radius overlaps the volume
+    bool overlaps(const AEVec2& pos, f32 radius) const;
+};
+
+// ==========================================
+//              TriggerRegistry
+// ==========================================
+// Volumes are registered every frame by the systems' update functions and dropped by dispatch,
+// so moved, rotated, placed or removed objects never leave stale volumes behind.
+class TriggerRegistry {
+public:
+    void addCircle(TriggerSystem system, const AEVec2& center, f32 radius,
+                   ITriggerListener* listener, u32 tag);
+
+    // rotationRad is the box's rotation, 0 for an axis-aligned box
+    void addOrientedBox(TriggerSystem system, const AEVec2& center, const AEVec2& halfExtents,
+                        f32 rotationRad, ITriggerListener* listener, u32 tag);
+
+    // Same, for callers that cache the cosine and sine of the box's rotation
+    void addOrientedBox(TriggerSystem system, const AEVec2& center, const AEVec2& halfExtents,
+                        f32 cosRotation, f32 sinRotation, ITriggerListener* listener, u32 tag);
+
+    // Claims a particle for removal: volumes dispatched later no longer see it and it is removed
+    // from the water pool once every listener has run
+    void consumeParticle(u32 particleIndex);
+
+    // Tests every water particle against the volumes bucketed under it, dispatches the hits in
+    // registration order, removes the consumed particles and clears the volumes. Volumes outside
+    // the water pool's bounding box sleep through the pass, and the pass is skipped if all do.
+    void dispatch(FluidSystem& fluidSystem, const FluidGrid& fluidGrid, f32 maxParticleRadius,
+                  CollisionStats& stats);
+
+    // Drops the volumes without testing them, e.g. when a level is unloaded
+    void clear();
+
+    size_t getVolumeCount() const { return volumes_.size(); }
+
+private:
+    using VolumeHit = std::pair<u32, u32>; // (volume, particle index)
+
+    std::vector<TriggerVolume> volumes_;
+
+    // Scratch buffers, kept between frames so a pass does not allocate
+    std::vector<std::vector<u32>> buckets_; // Volume indices per fluid grid cell
+    std::vector<u32> touchedBuckets_;       // Buckets filled this pass, cleared after it
+    std::vector<u32> awakeVolumes_;         // Volumes the water pool's bounding box overlaps
+    std::vector<u32> volumeChecks_;         // Particles tested per volume
+    std::vector<VolumeHit> hits_;
+    std::vector<u32> volumeHits_; // Unconsumed hits of the volume being dispatched
+    std::vector<u8> consumedMask_;
+    std::vector<u32> consumed_;
+
+    void bucketVolumes(const FluidGrid& fluidGrid, f32 maxParticleRadius);
+};
@@ -122,7 +122,8 @@ public:
 
     void setGraphicsConfig(VFXType type, const Graphics& gfxConfig);
 
-    void spawnVFX(VFXType type, AEVec2 position, f32 angleRad = 0.0f);
+    // countScale multiplies the type's burst size, e.g. one event standing in for several hits
+    void spawnVFX(VFXType type, AEVec2 position, f32 angleRad = 0.0f, f32 countScale = 1.0f);
 
     // Used together with ResetSpawnTimer
     void spawnContinuous(VFXType type, AEVec2 position, f32 deltaTime, f32 spawnRate = 0.1f);
@@ -149,7 +150,8 @@ private:
 
     EmitterConfig emitterConfigs_[static_cast<int>(VFXType::Count)];
 
-    void initializeEmitter(ParticleEmitter& emitter, VFXType type, AEVec2 pos, f32 angleRad);
+    void initializeEmitter(ParticleEmitter& emitter, VFXType type, AEVec2 pos, f32 angleRad,
+                           f32 countScale);
 
     ParticleEmitter* getFreeEmitter();
 
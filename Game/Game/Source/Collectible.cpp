@@ -25,7 +25,6 @@
 
 // Project
 #include "AudioSystem.h"
-#include "CollisionSystem.h"
 #include "ConfigManager.h"
 #include "MouseUtils.h"
 
@@ -195,44 +194,46 @@ void CollectibleSystem::loadLevelCollectibles(AEVec2 pos, CollectibleType type)
 
 // =========================================================
 //
-// CollectibleSystem::checkCollisionWithWater()
+// CollectibleSystem::update()
 //
-// - Returns false immediately if the collectible is inactive or collected.
-// - Computes the squared distance between the particle and collectible centres.
-// - Returns true if the squared distance is less than the squared sum of radii.
+// - Animates every collectible (see animate()).
+// - For each active uncollected collectible, registers its collider as a
+//   trigger circle, tagged with its index, for the fluid system's trigger
+//   pass (see onTriggerHits). The pass only buckets it into the fluid
+//   grid cells it covers, and skips it while no water is inside its
+//   bounds.
 //
 // =========================================================
-bool CollectibleSystem::checkCollisionWithWater(const Collectible& collectible,
-                                                const FluidParticle& particle) {
-    if (!collectible.active_ || collectible.collected_)
-        return false;
+void CollectibleSystem::update(f32 dt, FluidSystem& fluidSystem, VFXSystem& vfxSystem) {
+    TriggerRegistry& triggerRegistry = fluidSystem.getTriggerRegistry();
+    vfxSystem_ = &vfxSystem;
+    animate(dt);
 
-    AEVec2 delta = {particle.transform_.pos_.x - collectible.transform_.pos_.x,
-                    particle.transform_.pos_.y - collectible.transform_.pos_.y};
+    for (auto& c : collectibles_) {
+        if (!c.active_ || c.collected_)
+            continue;
 
-    f32 distSq = delta.x * delta.x + delta.y * delta.y;
-    f32 radiusSum = particle.collider_.shapeData_.circle_.radius_ +
-                    collectible.collider_.shapeData_.circle_.radius_;
-    return distSq < (radiusSum * radiusSum);
+        triggerRegistry.addCircle(TriggerSystem::Collectible, c.transform_.pos_,
+                                  c.collider_.shapeData_.circle_.radius_, this,
+                                  static_cast<u32>(&c - collectibles_.data()));
+    }
 }
 
 // =========================================================
 //
-// CollectibleSystem::update()
+// CollectibleSystem::animate()
 //
 // - Advances the global timer by delta time.
 // - For each active uncollected collectible:
 //   - Applies a sinusoidal pulse to the scale.
 //   - Applies a continuous rotation by rotationSpeed_.
-//   - Rebuilds the world transform matrix.
-//   - Checks collision against all water particles.
-//   - On collision, marks the collectible as collected, increments the
-//     count, spawns the appropriate VFX, and plays the bell sound.
+//   - Composes the world transform matrix in one step. Scale and
+//     rotation change every frame, so there is nothing to cache.
 // - Updates the collection counter text string.
+// - Touches no fluid system, so screens without water call it directly.
 //
 // =========================================================
-void CollectibleSystem::update(f32 dt, std::vector<FluidParticle>& particlePool,
-                               VFXSystem& vfxSystem) {
+void CollectibleSystem::animate(f32 dt) {
     globalTimer_ += dt;
 
     for (auto& c : collectibles_) {
@@ -244,36 +245,57 @@ void CollectibleSystem::update(f32 dt, std::vector<FluidParticle>& particlePool,
         c.transform_.scale_ = {30.0f * pulse, 30.0f * pulse};
 
         c.transform_.rotationRad_ += dt * c.rotationSpeed_;
+        composeWorldMtx(c.transform_.worldMtx_, c.transform_.pos_, c.transform_.scale_.x,
+                        AECos(c.transform_.rotationRad_), AESin(c.transform_.rotationRad_));
+    }
 
-        AEMtx33 scale, rot, trans;
-        AEMtx33Scale(&scale, c.transform_.scale_.x, c.transform_.scale_.y);
-        AEMtx33Rot(&rot, c.transform_.rotationRad_);
-        AEMtx33Trans(&trans, c.transform_.pos_.x, c.transform_.pos_.y);
-        AEMtx33Concat(&c.transform_.worldMtx_, &rot, &scale);
-        AEMtx33Concat(&c.transform_.worldMtx_, &trans, &c.transform_.worldMtx_);
-
-        for (const auto& particle : particlePool) {
-            if (checkCollisionWithWater(c, particle)) {
-                CollisionSystem::incrementCollisionCount();
-                c.collected_ = true;
-                collectedCount_++;
-                switch (c.type_) {
-                case CollectibleType::Star:
-                    vfxSystem.spawnVFX(VFXType::StarCollect, c.transform_.pos_);
-                    break;
-                case CollectibleType::Gem:
-                    vfxSystem.spawnVFX(VFXType::GemCollect, c.transform_.pos_);
-                    break;
-                case CollectibleType::Leaf:
-                    vfxSystem.spawnVFX(VFXType::LeafCollect, c.transform_.pos_);
-                    break;
-                }
-                g_audioSystem.playSound("bell", "sfx", 0.4f, 0.7f);
-                break;
-            }
-        }
+    updateCollectionText();
+}
+
+// =========================================================
+//
+// CollectibleSystem::onTriggerHits()
+//
+// - Called by the trigger pass when water touched a collectible.
+// - Marks the collectible as collected, increments the count, spawns
+//   the appropriate VFX, and plays the bell sound.
+//
+// =========================================================
+void CollectibleSystem::onTriggerHits(u32 tag, const std::vector<u32>& particleIndices,
+                                      TriggerRegistry& registry, FluidSystem& fluidSystem) {
+    (void)particleIndices;
+    (void)registry;
+    (void)fluidSystem;
+
+    Collectible& c = collectibles_[tag];
+    if (!c.active_ || c.collected_)
+        return;
+
+    c.collected_ = true;
+    collectedCount_++;
+    switch (c.type_) {
+    case CollectibleType::Star:
+        vfxSystem_->spawnVFX(VFXType::StarCollect, c.transform_.pos_);
+        break;
+    case CollectibleType::Gem:
+        vfxSystem_->spawnVFX(VFXType::GemCollect, c.transform_.pos_);
+        break;
+    case CollectibleType::Leaf:
+        vfxSystem_->spawnVFX(VFXType::LeafCollect, c.transform_.pos_);
+        break;
     }
+    g_audioSystem.playSound("bell", "sfx", 0.4f, 0.7f);
+    updateCollectionText();
+}
 
+// =========================================================
+//
+// CollectibleSystem::updateCollectionText()
+//
+// - Updates the collection counter text string.
+//
+// =========================================================
+void CollectibleSystem::updateCollectionText() {
     char buffer[32];
     snprintf(buffer, sizeof(buffer), "Items: %d/%d", collectedCount_, totalCollectibles_);
     collectionText_.content_ = buffer;
@@ -0,0 +1,107 @@
+/*!
+@file       CollisionContext.cpp
+@author     Sean Lee Hong Wei/seanhongwei.lee@digipen.edu
+@co_author  Woo Guang Theng/guangtheng.woo@digipen.edu,
+            Chia Hanxin/c.hanxin@digipen.edu
+
+@date		March, 31, 2026
+
+@brief      This source file contains the definitions of the per-world state
+            used by the collision system, namely the per-frame collision
+            statistics and their machine-readable dump.
+
+@copyright  Copyright (C) 2026 DigiPen Institute of Technology.
+            Reproduction or disclosure of this file or its contents
+            without the prior written consent of DigiPen Institute of
+            Technology is prohibited.
+*//*______________________________________________________________________*/
+
+// ==========================================
+//               Includes
+// ==========================================
+#include "CollisionContext.h"
+
+// Standard library
+#include <memory>
+
+// Third-party
+#include <json/json.h>
+
+// =========================================================
+//
+//  CollisionStats's totalHits function
+//
+// Sums every kind of contact recorded this frame, matching the
+// single collision count the HUD used to show.
+//
+// =========================================================
+u32 CollisionStats::totalHits() const {
+    u32 total = fluidPairsResolved_ + terrainCellsHit_;
+    for (u32 hits : triggerHits_)
+        total += hits;
+    return total;
+}
+
+// =========================================================
+//
+//  CollisionStats's recordTriggerCheck function
+//
+// Counts a single trigger volume vs particle check made by a
+// gameplay system (portals, moss, collectibles, the end point).
+//
+// =========================================================
+void CollisionStats::recordTriggerCheck(TriggerSystem system, bool hit) {
+    const int index = static_cast<int>(system);
+    ++triggerChecks_[index];
+    if (hit)
+        ++triggerHits_[index];
+}
+
+// =========================================================
+//
+//  CollisionStats's recordTriggerChecks function
+//
+// Counts the particles tested and hit by one trigger volume
+// of a gameplay system in the trigger pass.
+//
+// =========================================================
+void CollisionStats::recordTriggerChecks(TriggerSystem system, u32 checks, u32 hits) {
+    const int index = static_cast<int>(system);
+    triggerChecks_[index] += checks;
+    triggerHits_[index] += hits;
+}
+
+// =========================================================
+//
+//  CollisionContext's writeFrameStats function
+//
+// Serialises the current frame stats as one compact JSON object
+// per line, so captures can be diffed or plotted offline.
+//
+// =========================================================
+void CollisionContext::writeFrameStats(std::ostream& os, u32 frame) const {
+    static const char* const kTriggerNames[static_cast<int>(TriggerSystem::Count)] = {
+        "portal", "moss", "collectible", "endPoint"};
+
+    Json::Value root;
+    root["frame"] = frame;
+    root["fluidPairsTested"] = frameStats_.fluidPairsTested_;
+    root["fluidPairsResolved"] = frameStats_.fluidPairsResolved_;
+    root["terrainCellsTested"] = frameStats_.terrainCellsTested_;
+    root["terrainCellsHit"] = frameStats_.terrainCellsHit_;
+    root["terrainWarmStartHits"] = frameStats_.terrainWarmStartHits_;
+    for (int i = 0; i < static_cast<int>(TriggerSystem::Count); ++i) {
+        root["triggerChecks"][kTriggerNames[i]] = frameStats_.triggerChecks_[i];
+        root["triggerHits"][kTriggerNames[i]] = frameStats_.triggerHits_[i];
+    }
+    root["gridBuilds"] = frameStats_.gridBuilds_;
+    root["gridBuildTimeMs"] = frameStats_.gridBuildTimeMs_;
+    root["broadphaseOccupied"] = broadphaseStats_.occupiedBuckets_;
+    root["broadphaseMaxPerBucket"] = broadphaseStats_.maxPerBucket_;
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = ""; // one object per line
+    std::unique_ptr<Json::StreamWriter> jsonWriter(builder.newStreamWriter());
+    jsonWriter->write(root, &os);
+    os << '\n';
+}
@@ -9,7 +9,7 @@
 @brief      This source file contains the definitions of functions and classes
             for the collision detection and resolution system which includes the following:
 
-                - CollisionSystem, a static utility class that manages spatial
+                - CollisionSystem, a stateless utility class that manages spatial
                   partitioning, intersection detection, and physics resolution
                   between fluid particles and terrain geometry.
                 - Geometric Utility functions for point-in-triangle tests,
@@ -31,7 +31,9 @@
 // ==========================================
 #include "CollisionSystem.h"
 
-u32 CollisionSystem::collisionCount_ = 0;
+// Standard library
+#include <chrono>
+#include <cstdint>
 
 // ==========================================
 //              CollisionSystem
@@ -46,55 +48,38 @@ u32 CollisionSystem::collisionCount_ = 0;
 // within a single physics substep.
 //
 // The list of optimisations include:
-// - Uses static vectors for the spatial grid to avoid frequent heap allocations
+// - Reuses the world's broadphase grid from its CollisionContext to avoid frequent heap
+//   allocations, without any static state shared between worlds
+// - Sizes broadphase buckets from the particle interaction radius, not the terrain tile size
 // - Caches terrain collider availability to skip empty air cells
 // - Employs memory address comparison to ensure each particle pair is resolved only once
 // - Utilizes a 3x3 neighborhood search to limit collision checks to local particles
 //
 // =========================================================
 void CollisionSystem::terrainToFluidCollision(Terrain& terrain, FluidSystem& fluidSystem, f32 dt) {
-    using BucketEntry = std::pair<FluidType, u32>; // (type, index)
-
-    // Grid info
-    const u32 gridRows = terrain.getCellRows();
-    const u32 gridCols = terrain.getCellCols();
-    const u32 gridSize = terrain.getCellSize();
-    const AEVec2 gridBottomLeftPos = terrain.getBottomLeftPos();
-
-    const size_t totalCells = static_cast<size_t>(gridRows) * static_cast<size_t>(gridCols);
-
-    // OPTIMISATION: Static vectors persist between calls so they are only allocated ONCE.
-    // Without static, C++ would allocate and destroy these vectors every single call
-    // this function runs 8 times per frame (4 substeps x 2 terrains), so that's
-    // 8 heap allocations avoided per frame.
-    static std::vector<std::vector<BucketEntry>> fluidGrid;
-    static size_t cachedTotalCells = 0;
-
-    // Resize fluidGrid once based on terrainGrid
-    if (cachedTotalCells != totalCells) {
-        fluidGrid.resize(totalCells);
-        cachedTotalCells = totalCells;
-    }
-
-    // cellHasColliders lives inside each Terrain instance dirt and stone
-    // each have their own copy so they never contaminate each other.
-    // The dirty flag on the terrain tells us when to recompute.
-    std::vector<bool>& cellHasColliders = terrain.getCachedHasColliders();
-
-    if (terrain.isCollidersCacheDirty() || cellHasColliders.size() != totalCells) {
-        cellHasColliders.resize(totalCells, false);
-        for (size_t i = 0; i < totalCells; ++i) {
-            const Cell& c = terrain.getCells()[i];
-            cellHasColliders[i] = false;
-            for (u32 j = 0; j < 3; ++j) {
-                if (c.colliders_[j].colliderShape_ != ColliderShape::Empty) {
-                    cellHasColliders[i] = true;
-                    break;
-                }
-            }
-        }
-        terrain.markCollidersCacheClean();
-    }
+    // Scratch buffers and counters of the world being stepped
+    CollisionContext& context = fluidSystem.getCollisionContext();
+    CollisionStats& stats = context.frameStats_;
+
+    // Terrain grid info
+    const u32 terrainRows = terrain.getCellRows();
+    const u32 terrainCols = terrain.getCellCols();
+    const f32 terrainCellSize = static_cast<f32>(terrain.getCellSize());
+
+    // OPTIMISATION: The grid lives in the world's context and persists between calls, so its
+    // buckets are only allocated when the covered area or the broadphase cell size changes.
+    // Without it, C++ would allocate and destroy every bucket each call and this function runs
+    // once per substep (4 times per frame).
+    FluidGrid& fluidGrid = context.fluidGrid_;
+
+    // The broadphase covers the terrain's world area, but is bucketed at its own resolution.
+    resizeGrid(fluidGrid, fluidSystem, terrain.getBottomLeftPos(),
+               terrainCellSize * static_cast<f32>(terrainCols),
+               terrainCellSize * static_cast<f32>(terrainRows));
+
+    const u32 gridRows = fluidGrid.rows_;
+    const u32 gridCols = fluidGrid.cols_;
+    const size_t totalBuckets = fluidGrid.buckets_.size();
 
     // ====================================================================
     // PASS 1: FLUID vs FLUID
@@ -103,18 +88,24 @@ void CollisionSystem::terrainToFluidCollision(Terrain& terrain, FluidSystem& flu
     // stacked particles is resolved before terrain pushes them out.
 
     // Currently, fluidGrid is empty so we populate it first
-    buildGrid(fluidGrid, fluidSystem, gridBottomLeftPos, gridCols, gridRows, gridSize);
-    for (size_t cell = 0; cell < totalCells; ++cell) {
+    const auto gridBuildStart = std::chrono::steady_clock::now();
+    buildGrid(fluidGrid, fluidSystem, context.broadphaseStats_);
+    const std::chrono::duration<f32, std::milli> gridBuildTime =
+        std::chrono::steady_clock::now() - gridBuildStart;
+    ++stats.gridBuilds_;
+    stats.gridBuildTimeMs_ += gridBuildTime.count();
+    for (size_t cell = 0; cell < totalBuckets; ++cell) {
 
         // If cell is empty, skip
-        if (fluidGrid[cell].empty())
+        if (fluidGrid.buckets_[cell].empty())
             continue;
 
         const u32 cx = static_cast<u32>(cell % gridCols);
         const u32 cy = static_cast<u32>(cell / gridCols);
 
         // Check the 3x3 neighbourhood around each occupied cell.
-        // This ensures we catch pairs that are in adjacent cells.
+        // The bucket size is at least the largest contact distance, so this ensures we catch
+        // every pair that is in adjacent cells.
         for (int dy = -1; dy <= 1; ++dy) {
             for (int dx = -1; dx <= 1; ++dx) {
                 const int nx = static_cast<int>(cx) + dx;
@@ -130,11 +121,11 @@ void CollisionSystem::terrainToFluidCollision(Terrain& terrain, FluidSystem& flu
                     static_cast<size_t>(nx);
 
                 // BucketEntry = std::pair<FluidType, u32>
-                std::vector<BucketEntry>& neighbourParticles = fluidGrid[neighbourIndex];
+                std::vector<BucketEntry>& neighbourParticles = fluidGrid.buckets_[neighbourIndex];
                 if (neighbourParticles.empty())
                     continue;
 
-                for (const BucketEntry& a : fluidGrid[cell]) {
+                for (const BucketEntry& a : fluidGrid.buckets_[cell]) {
                     FluidParticle& fluidParticleA = fluidSystem.getParticlePool(a.first)[a.second];
 
                     for (const BucketEntry& b : neighbourParticles) {
@@ -146,7 +137,8 @@ void CollisionSystem::terrainToFluidCollision(Terrain& terrain, FluidSystem& flu
                         // visits B, and again when B visits A which equals to
                         // double the work.
                         if (&fluidParticleA < &fluidParticleB) {
-                            resolveFluidParticlePair(fluidParticleA, fluidParticleB);
+                            ++stats.fluidPairsTested_;
+                            resolveFluidParticlePair(fluidParticleA, fluidParticleB, stats);
                         }
                     }
                 }
@@ -159,60 +151,147 @@ void CollisionSystem::terrainToFluidCollision(Terrain& terrain, FluidSystem& flu
     // ====================================================================
     // Strictly enforces terrain boundaries.
     // A substep just for solving fluid to terrain collisions
-    // Runs TWICE per substep to catch any particles that Pass 1's fluid-fluid pressure pushed into
-    // walls.
+    //
+    // Each particle is tested directly against the terrain cells its collider overlaps, so this
+    // pass no longer needs the broadphase grid to share the terrain's cell size.
+    for (u32 t = 0; t < static_cast<u32>(FluidType::Count); ++t) {
+        for (FluidParticle& fluidParticle :
+             fluidSystem.getParticlePool(static_cast<FluidType>(t))) {
+            particleToTerrainCollision(terrain, fluidParticle, dt, stats);
+        }
+    }
+}
 
-    for (int terrainPass = 0; terrainPass < 1; ++terrainPass) {
-        // Only rebuild the grid on the first iteration, the second iteration doesn't move particles
-        // far enough to change their grid cell, so rebuilding a second time would be inefficient.
-        if (terrainPass == 0)
-            buildGrid(fluidGrid, fluidSystem, gridBottomLeftPos, gridCols, gridRows, gridSize);
+// =========================================================
+//
+//  CollisionSystem's particleToTerrainCollision function
+//
+// Resolves a single particle against every terrain cell that its
+// circle collider overlaps.
+// - The cached contact from the last substep is tested first; while it
+//   holds it decides whether the floor impact spread is skipped
+// - When that contact is resolved and the collider still lies inside the
+//   contact's cell, the particle is done: a cell resolves one contact per
+//   substep and no neighbour can be touched
+// - Otherwise the cell loop runs, skipping only the collider slot the
+//   cached contact already resolved, so a second contact (a wall or slope
+//   next to the floor the particle rests on) is never missed
+// - Contacts cached against an earlier generation of the terrain (re-
+//   initialised, or a new terrain at the same address) are dropped
+//
+// The list of optimisations include:
+// - Warm-starts from the particle's cached contact, so a resting particle
+//   keeps its persistent contact without re-searching for it
+// - Maps the collider's bounding box straight to a terrain cell range
+// - Skips particles that lie completely outside the terrain
+// - Skips cells with no terrain colliders using the terrain's cached flags
+//
+// =========================================================
+void CollisionSystem::particleToTerrainCollision(Terrain& terrain, FluidParticle& fluidParticle,
+                                                 f32 dt, CollisionStats& stats) {
+    // Contacts whose normal stays within ~25 degrees of the cached one count as the same surface
+    const f32 kPersistentNormalDot = 0.9f;
 
-        for (size_t cell = 0; cell < totalCells; ++cell) {
-            if (fluidGrid[cell].empty())
+    TerrainContactCache& cache = fluidParticle.terrainContact_;
+    const f32 radius = fluidParticle.collider_.shapeData_.circle_.radius_;
+
+    // Cell and slot resolved by the warm start, left out of the cell loop below
+    size_t warmCellIndex = SIZE_MAX;
+    s32 warmSlot = -1;
+
+    // ====================================================================
+    // WARM START: re-test the collider this particle touched last substep
+    // ====================================================================
+    // Settled water rests on the same collider substep after substep. Resolving it first keeps
+    // the contact persistent (no floor impact spread) while the cell loop handles the rest.
+    if (cache.terrain_ == &terrain) {
+        if (cache.generation_ == terrain.getGeneration() &&
+            cache.cellIndex_ < terrain.getCellCount()) {
+            ++stats.terrainCellsTested_;
+            CollisionInfo contact = colliderToFluidParticleCollision(
+                terrain.getCell(cache.cellIndex_), cache.colliderSlot_, fluidParticle);
+            if (contact.hasCollision_) {
+                const bool persistent = vDot(contact.normal_, cache.normal_) > kPersistentNormalDot;
+                ++stats.terrainCellsHit_;
+                ++stats.terrainWarmStartHits_;
+                pushOutAndSlide(fluidParticle, contact.normal_, contact.penetration_, radius, dt,
+                                persistent);
+                cache.normal_ = contact.normal_;
+                warmCellIndex = cache.cellIndex_;
+                warmSlot = static_cast<s32>(cache.colliderSlot_);
+            }
+        }
+
+        // Contact lost (particle moved away or the terrain was edited)
+        if (warmSlot < 0)
+            cache.terrain_ = nullptr;
+    }
+
+    const s32 terrainRows = static_cast<s32>(terrain.getCellRows());
+    const s32 terrainCols = static_cast<s32>(terrain.getCellCols());
+    const f32 terrainCellSize = static_cast<f32>(terrain.getCellSize());
+    const AEVec2 terrainBottomLeftPos = terrain.getBottomLeftPos();
+
+    const AEVec2 center =
+        vAdd(fluidParticle.transform_.pos_, fluidParticle.collider_.shapeData_.circle_.offset_);
+
+    // Terrain cells touched by the collider's bounding box
+    s32 minX = static_cast<s32>(
+        std::floor((center.x - radius - terrainBottomLeftPos.x) / terrainCellSize));
+    s32 maxX = static_cast<s32>(
+        std::floor((center.x + radius - terrainBottomLeftPos.x) / terrainCellSize));
+    s32 minY = static_cast<s32>(
+        std::floor((center.y - radius - terrainBottomLeftPos.y) / terrainCellSize));
+    s32 maxY = static_cast<s32>(
+        std::floor((center.y + radius - terrainBottomLeftPos.y) / terrainCellSize));
+
+    if (maxX < 0 || maxY < 0 || minX >= terrainCols || minY >= terrainRows)
+        return;
+
+    minX = (std::max)(minX, 0);
+    minY = (std::max)(minY, 0);
+    maxX = (std::min)(maxX, terrainCols - 1);
+    maxY = (std::min)(maxY, terrainRows - 1);
+
+    // EARLY OUT: the warm contact pushed the particle clear and its collider still lies inside
+    // that one cell. Cells resolve a single contact per substep, so nothing is left to test.
+    if (warmSlot >= 0 && minX == maxX && minY == maxY) {
+        const size_t onlyCell =
+            static_cast<size_t>(minY) * static_cast<size_t>(terrainCols) + static_cast<size_t>(minX);
+        if (onlyCell == warmCellIndex)
+            return;
+    }
+
+    for (s32 cy = minY; cy <= maxY; ++cy) {
+        for (s32 cx = minX; cx <= maxX; ++cx) {
+            const size_t cellIndex =
+                static_cast<size_t>(cy) * static_cast<size_t>(terrainCols) +
+                static_cast<size_t>(cx);
+
+            // OPTIMISATION: Skip cells with no terrain colliders entirely.
+            // The vast majority of grid cells are empty air skipping them
+            // avoids running the expensive triangle/AABB detection math
+            // on cells that can never produce a collision.
+            if (!terrain.cellHasColliders(cellIndex))
                 continue;
 
-            const u32 cx = static_cast<u32>(cell % gridCols);
-            const u32 cy = static_cast<u32>(cell / gridCols);
-
-            for (int dy = -1; dy <= 1; ++dy) {
-                for (int dx = -1; dx <= 1; ++dx) {
-                    const int nx = static_cast<int>(cx) + dx;
-                    const int ny = static_cast<int>(cy) + dy;
-
-                    if (nx < 0 || nx >= static_cast<int>(gridCols) || ny < 0 ||
-                        ny >= static_cast<int>(gridRows))
-                        continue;
-
-                    const size_t neighbourIndex =
-                        static_cast<size_t>(ny) * static_cast<size_t>(gridCols) +
-                        static_cast<size_t>(nx);
-
-                    // OPTIMISATION: Skip cells with no terrain colliders entirely.
-                    // The vast majority of grid cells are empty air skipping them
-                    // avoids running the expensive triangle/AABB detection math
-                    // on cells that can never produce a collision.
-                    if (!cellHasColliders[neighbourIndex])
-                        continue;
-
-                    Cell& neighbourTerrainCell = terrain.getCells()[neighbourIndex];
-
-                    // Loops through every particle within the selected cell
-                    for (const BucketEntry& a : fluidGrid[cell]) {
-                        FluidParticle& fluidParticleA =
-                            fluidSystem.getParticlePool(a.first)[a.second];
-
-                        // Returns contact info based on whether there is collision detected or not
-                        // (If not, nothing happens at all)
-                        CollisionInfo contact =
-                            cellToFluidParticleCollision(neighbourTerrainCell, fluidParticleA);
-                        if (contact.hasCollision_) {
-                            incrementCollisionCount();
-                            pushOutAndSlide(fluidParticleA, contact.normal_, contact.penetration_,
-                                            fluidParticleA.collider_.shapeData_.circle_.radius_,
-                                            dt);
-                        }
-                    }
+            // Returns contact info based on whether there is collision detected or not
+            // (If not, nothing happens at all)
+            ++stats.terrainCellsTested_;
+            CollisionInfo contact = cellToFluidParticleCollision(
+                terrain.getCell(cellIndex), fluidParticle,
+                cellIndex == warmCellIndex ? warmSlot : -1);
+            if (contact.hasCollision_) {
+                ++stats.terrainCellsHit_;
+                pushOutAndSlide(fluidParticle, contact.normal_, contact.penetration_, radius, dt);
+
+                // Remember the first contact found so the next substep can warm-start from it
+                if (cache.terrain_ == nullptr) {
+                    cache.terrain_ = &terrain;
+                    cache.generation_ = terrain.getGeneration();
+                    cache.cellIndex_ = static_cast<u32>(cellIndex);
+                    cache.colliderSlot_ = static_cast<u32>(contact.colliderSlot_);
+                    cache.normal_ = contact.normal_;
                 }
             }
         }
@@ -239,7 +318,7 @@ AEVec2 CollisionSystem::vNormalizeOr(const AEVec2& v, const AEVec2& fallback) {
     return AEVec2{v.x * inv, v.y * inv};
 }
 
-// Apply terrain cell transform to a local point (scale -> rotate -> translate)
+// Apply terrain cell placement to a local point (scale -> translate)
 // =========================================================
 //
 //  CollisionSystem's localToWorldPoint function
@@ -248,25 +327,12 @@ AEVec2 CollisionSystem::vNormalizeOr(const AEVec2& v, const AEVec2& fallback) {
 // absolute world-space coordinates.
 //
 // The list of optimisations include:
-// - Skips sine and cosine operations if the cell rotation is zero
+// - Terrain cells never rotate, so no sine and cosine operations are needed
 // - Directly calculates the transformed X and Y components to avoid matrix overhead
 //
 // =========================================================
-AEVec2 CollisionSystem::localToWorldPoint(const AEVec2& local, const Transform& t) {
-    AEVec2 s{local.x * t.scale_.x, local.y * t.scale_.y};
-
-    // OPTIMISATION: All terrain cells have rotationRad_ = 0 during gameplay.
-    // std::cos(0) = 1 and std::sin(0) = 0, so the rotation matrix simplifies to
-    // just a translation. Skipping cos/sin here saves significant CPU time since
-    // this function is called for every triangle vertex of every terrain collision check.
-    if (t.rotationRad_ == 0.0f) {
-        return AEVec2{s.x + t.pos_.x, s.y + t.pos_.y};
-    }
-
-    const f32 c = std::cos(t.rotationRad_);
-    const f32 sn = std::sin(t.rotationRad_);
-    AEVec2 r{s.x * c - s.y * sn, s.x * sn + s.y * c};
-    return AEVec2{r.x + t.pos_.x, r.y + t.pos_.y};
+AEVec2 CollisionSystem::localToWorldPoint(const AEVec2& local, const Cell& cell) {
+    return AEVec2{local.x * cell.size_ + cell.pos_.x, local.y * cell.size_ + cell.pos_.y};
 }
 
 // Closest point on a segment AB to point P
@@ -364,82 +430,104 @@ bool CollisionSystem::pointInTriangle(const AEVec2& p, const AEVec2& a, const AE
 // check for intersections with an inputted particle.
 //
 // The list of optimisations include:
-// - Skips slots marked as ColliderShape::Empty
-// - Automatically resolves world-space offsets and scaling for box colliders
+// - Skips slots marked as ColliderShape::Empty, and skipSlot (the slot
+//   the warm start already resolved, -1 for none)
 // - Returns contact info for only the first valid collision detected to prevent over-resolution
 //
 // =========================================================
 CollisionInfo CollisionSystem::cellToFluidParticleCollision(const Cell& cell,
-                                                            const FluidParticle& fluidParticle) {
+                                                            const FluidParticle& fluidParticle,
+                                                            s32 skipSlot) {
+    for (u32 i = 0; i < 3; ++i) {
+        if (static_cast<s32>(i) == skipSlot)
+            continue;
+        // Even if there are more than 2 colliders in the cell, the particle should only collide
+        // with the FIRST collider it hits. Collision response will then occur based on that first
+        // collision's normal and penetration values. If the particle gets pushed into another
+        // collider in the same frame, its okay as it will be resolved in the next frame when we
+        // check for collisions again.
+        CollisionInfo contact = colliderToFluidParticleCollision(cell, i, fluidParticle);
+        if (contact.hasCollision_)
+            return contact;
+    }
+
+    return CollisionInfo{}; // Returns hasCollision = false if nothing was hit
+}
+
+// =========================================================
+//
+// CollisionSystem's colliderToFluidParticleCollision function
+//
+// Checks a single collider slot of a terrain grid cell for an
+// intersection with an inputted particle.
+//
+// The list of optimisations include:
+// - Early-outs on slots marked as ColliderShape::Empty
+// - Automatically resolves world-space offsets and scaling for box colliders
+// - Lets cached contacts re-test one collider instead of the whole neighbourhood
+//
+// =========================================================
+CollisionInfo
+CollisionSystem::colliderToFluidParticleCollision(const Cell& cell, u32 slot,
+                                                  const FluidParticle& fluidParticle) {
 
     CollisionInfo contact{};
 
+    const Collider2D& col = cell.colliders_[slot];
+    if (col.colliderShape_ == ColliderShape::Empty)
+        return contact;
+
     const AEVec2 circleCenter =
         vAdd(fluidParticle.transform_.pos_, fluidParticle.collider_.shapeData_.circle_.offset_);
     const f32 radius = fluidParticle.collider_.shapeData_.circle_.radius_;
     const AEVec2 velocity = fluidParticle.physics_.velocity_;
 
-    for (u32 i = 0; i < 3; ++i) {
-        const Collider2D& col = cell.colliders_[i];
-        if (col.colliderShape_ == ColliderShape::Empty)
-            continue;
-
-        AEVec2 n{0.0f, 1.0f};
-        f32 penetration = 0.0f;
-        bool hit = false;
-
-        if (col.colliderShape_ == ColliderShape::Box) {
-            // This takes the box's local offset and stretches it by the cell's actual physical size
-            // on the screen.
-            const AEVec2 offsetWorld{col.shapeData_.box_.offset_.x * cell.transform_.scale_.x,
-                                     col.shapeData_.box_.offset_.y * cell.transform_.scale_.y};
-
-            // This takes the exact world coordinates of the Grid Cell itself,
-            // and adds the offsetWorld to get the exact pixel coordinate of the Box's center.
-            const AEVec2 boxCenter = vAdd(cell.transform_.pos_, offsetWorld);
-
-            // This stretches the local width/height of the box by the cell's scale to get the true
-            // pixel dimensions.
-            const AEVec2 sizeWorld{col.shapeData_.box_.size_.x * cell.transform_.scale_.x,
-                                   col.shapeData_.box_.size_.y * cell.transform_.scale_.y};
-
-            // halfExt just refers to half-width/half-height, calculated now so that future
-            // calculations arent needed.
-            const AEVec2 halfExt{sizeWorld.x * 0.5f, sizeWorld.y * 0.5f};
-
-            hit = detectCircleVsAABB(circleCenter, radius, velocity, boxCenter, halfExt, n,
-                                     penetration);
-        } else if (col.colliderShape_ == ColliderShape::Triangle) {
-            // @todo comment
-            const AEVec2 v0 =
-                localToWorldPoint(col.shapeData_.triangle_.vertices_[0], cell.transform_);
-            const AEVec2 v1 =
-                localToWorldPoint(col.shapeData_.triangle_.vertices_[1], cell.transform_);
-            const AEVec2 v2 =
-                localToWorldPoint(col.shapeData_.triangle_.vertices_[2], cell.transform_);
-
-            hit =
-                detectCircleVsTriangle(circleCenter, radius, velocity, v0, v1, v2, n, penetration);
-        }
-
-        // If any of the two collisions above occur, we return contact information so that collision
-        // response can occur in the calling function.
-        //
-        // Even if there are more than 2 colliders in the cell, the particle should only collide
-        // with the FIRST collider it hits. Collision response will then occur based on that first
-        // collision's normal and penetration values. If the particle gets pushed into another
-        // collider in the same frame, its okay as it will be resolved in the next frame when we
-        // check for collisions again.
+    AEVec2 n{0.0f, 1.0f};
+    f32 penetration = 0.0f;
+    bool hit = false;
+
+    if (col.colliderShape_ == ColliderShape::Box) {
+        // This takes the box's local offset and stretches it by the cell's actual physical size
+        // on the screen.
+        const AEVec2 offsetWorld{col.shapeData_.box_.offset_.x * cell.size_,
+                                 col.shapeData_.box_.offset_.y * cell.size_};
+
+        // This takes the exact world coordinates of the Grid Cell itself,
+        // and adds the offsetWorld to get the exact pixel coordinate of the Box's center.
+        const AEVec2 boxCenter = vAdd(cell.pos_, offsetWorld);
+
+        // This stretches the local width/height of the box by the cell's scale to get the true
+        // pixel dimensions.
+        const AEVec2 sizeWorld{col.shapeData_.box_.size_.x * cell.size_,
+                               col.shapeData_.box_.size_.y * cell.size_};
+
+        // halfExt just refers to half-width/half-height, calculated now so that future
+        // calculations arent needed.
+        const AEVec2 halfExt{sizeWorld.x * 0.5f, sizeWorld.y * 0.5f};
+
+        hit = detectCircleVsAABB(circleCenter, radius, velocity, boxCenter, halfExt, n,
+                                 penetration);
+    } else if (col.colliderShape_ == ColliderShape::Triangle) {
+        // Slide any edge midpoint to the cell's interpolated crossing, then place it in the world
+        const AEVec2(&local)[3] = col.shapeData_.triangle_.vertices_;
+        const MarchingSquares::CellEdges& edges = cell.edges_;
+        const AEVec2 v0 = localToWorldPoint(MarchingSquares::placeVertex(local[0], edges), cell);
+        const AEVec2 v1 = localToWorldPoint(MarchingSquares::placeVertex(local[1], edges), cell);
+        const AEVec2 v2 = localToWorldPoint(MarchingSquares::placeVertex(local[2], edges), cell);
+
+        hit = detectCircleVsTriangle(circleCenter, radius, velocity, v0, v1, v2, n, penetration);
+    }
 
-        if (hit) {
-            contact.hasCollision_ = true;
-            contact.normal_ = vNormalizeOr(n, AEVec2{0.0f, 1.0f});
-            contact.penetration_ = penetration;
-            return contact;
-        }
+    // If any of the two collisions above occur, we return contact information so that collision
+    // response can occur in the calling function.
+    if (hit) {
+        contact.hasCollision_ = true;
+        contact.normal_ = vNormalizeOr(n, AEVec2{0.0f, 1.0f});
+        contact.penetration_ = penetration;
+        contact.colliderSlot_ = static_cast<s32>(slot);
     }
 
-    return contact; // Returns hasCollision = false if nothing was hit
+    return contact;
 }
 
 // Helper function for cellToFluidParticleCollision: detects Circle vs Triangle collision in world
@@ -636,11 +724,12 @@ bool CollisionSystem::detectCircleVsAABB(const AEVec2& circleCenter, f32 radius,
 // The list of optimisations include:
 // - Incorporates a tiny "slop" value to prevent micro-jitter from floating point errors
 // - Converts vertical impact into horizontal "Floor Impact Spread" for fluid behavior
+// - Skips the spread for persistent (warm-started) contacts so resting water stays settled
 // - Applies randomized friction to prevent uniform velocity across the fluid pool
 //
 // =========================================================
 void CollisionSystem::pushOutAndSlide(FluidParticle& p, const AEVec2& n, f32 penetration,
-                                      f32 radius, f32 dt) {
+                                      f32 radius, f32 dt, bool persistentContact) {
     // DT Clamp
     if (dt > 0.016667f) {
         dt = 0.016667f;
@@ -668,7 +757,10 @@ void CollisionSystem::pushOutAndSlide(FluidParticle& p, const AEVec2& n, f32 pen
         // up vertically instead of spreading sideways like real water.
         // If the particle is already moving horizontally, amplify that direction so
         // flow is consistent rather than randomly reversing.
-        if (n.y > 0.5f) {
+        //
+        // A persistent contact is a particle already resting on this surface, so there is no new
+        // impact to convert and re-injecting random spread every substep only makes it jitter.
+        if (n.y > 0.5f && !persistentContact) {
             f32 impactSpeed = std::abs(vn);
             // Always picks a random direction - previously amplified existing horizontal drift
             // which caused all water to bias rightward. Random direction ensures symmetric
@@ -700,7 +792,8 @@ void CollisionSystem::pushOutAndSlide(FluidParticle& p, const AEVec2& n, f32 pen
 // - Uses a minimum bounce threshold to stop vigorous oscillation in resting fluid
 //
 // =========================================================
-void CollisionSystem::resolveFluidParticlePair(FluidParticle& p1, FluidParticle& p2) {
+void CollisionSystem::resolveFluidParticlePair(FluidParticle& p1, FluidParticle& p2,
+                                               CollisionStats& stats) {
 
     // Calculate distance between p1 and p2
     f32 dx = p1.transform_.pos_.x - p2.transform_.pos_.x;
@@ -723,7 +816,7 @@ void CollisionSystem::resolveFluidParticlePair(FluidParticle& p1, FluidParticle&
 
     // Check collision
     if (distSq < minDist * minDist) {
-        incrementCollisionCount();
+        ++stats.fluidPairsResolved_;
         // std::max prevents division by zero if dist is extremely small
         f32 dist = std::sqrt((std::max)(distSq, 0.0001f));
 
@@ -830,12 +923,39 @@ void CollisionSystem::resolveFluidParticlePair(FluidParticle& p1, FluidParticle&
     }
 }
 
+// =========================================================
+//
+//  CollisionSystem's resizeGrid function
+//
+// Fits the broadphase grid over a world area using the fluid
+// system's broadphase cell size.
+//
+// The list of optimisations include:
+// - Only reallocates buckets when the bucket count actually changes
+// - Keeps bucket capacity alive between substeps so rebuilding is allocation free
+//
+// =========================================================
+void CollisionSystem::resizeGrid(FluidGrid& fluidGrid, const FluidSystem& fluidSystem,
+                                 const AEVec2& areaBottomLeftPos, f32 areaWidth, f32 areaHeight) {
+    const f32 cellSize = fluidSystem.getBroadphaseCellSize();
+
+    fluidGrid.bottomLeftPos_ = areaBottomLeftPos;
+    fluidGrid.cellSize_ = cellSize;
+    fluidGrid.cols_ = (std::max)(1u, static_cast<u32>(std::ceil(areaWidth / cellSize)));
+    fluidGrid.rows_ = (std::max)(1u, static_cast<u32>(std::ceil(areaHeight / cellSize)));
+
+    const size_t totalBuckets =
+        static_cast<size_t>(fluidGrid.cols_) * static_cast<size_t>(fluidGrid.rows_);
+    if (fluidGrid.buckets_.size() != totalBuckets)
+        fluidGrid.buckets_.resize(totalBuckets);
+}
+
 // =========================================================
 //
 //  CollisionSystem's buildGrid function
 //
 // Populates the spatial partitioning structure with all active particles
-// before starting the collision loop.
+// before starting the collision loop, and records its occupancy stats.
 //
 // The list of optimisations include:
 // - Uses floor-based division to map world positions directly to grid indices
@@ -843,12 +963,14 @@ void CollisionSystem::resolveFluidParticlePair(FluidParticle& p1, FluidParticle&
 // - Groups particles by type and index to preserve pool efficiency
 //
 // =========================================================
-void CollisionSystem::buildGrid(std::vector<std::vector<BucketEntry>>& fluidGrid,
-                                FluidSystem& fluidSystem, const AEVec2& gridBottomLeftPos,
-                                u32 gridCols, u32 gridRows, u32 gridSize) {
-    for (auto& bucket : fluidGrid)
+void CollisionSystem::buildGrid(FluidGrid& fluidGrid, FluidSystem& fluidSystem,
+                                BroadphaseStats& broadphaseStats) {
+    for (auto& bucket : fluidGrid.buckets_)
         bucket.clear();
 
+    const f32 invCellSize = 1.0f / fluidGrid.cellSize_;
+    u32 outOfGrid = 0;
+
     for (u32 t = 0; t < static_cast<u32>(FluidType::Count); ++t) {
         std::vector<FluidParticle>& particlePool =
             fluidSystem.getParticlePool(static_cast<FluidType>(t));
@@ -858,18 +980,43 @@ void CollisionSystem::buildGrid(std::vector<std::vector<BucketEntry>>& fluidGrid
             AEVec2 particlePos = particle.transform_.pos_;
 
             s32 particleCellX = static_cast<s32>(
-                std::floor((particlePos.x - gridBottomLeftPos.x) / static_cast<f32>(gridSize)));
+                std::floor((particlePos.x - fluidGrid.bottomLeftPos_.x) * invCellSize));
             s32 particleCellY = static_cast<s32>(
-                std::floor((particlePos.y - gridBottomLeftPos.y) / static_cast<f32>(gridSize)));
+                std::floor((particlePos.y - fluidGrid.bottomLeftPos_.y) * invCellSize));
 
-            if (particleCellX < 0 || particleCellX >= static_cast<int>(gridCols) ||
-                particleCellY < 0 || particleCellY >= static_cast<int>(gridRows))
+            if (particleCellX < 0 || particleCellX >= static_cast<s32>(fluidGrid.cols_) ||
+                particleCellY < 0 || particleCellY >= static_cast<s32>(fluidGrid.rows_)) {
+                ++outOfGrid;
                 continue;
+            }
 
             const size_t cellIndex =
-                static_cast<size_t>(particleCellY) * static_cast<size_t>(gridCols) +
+                static_cast<size_t>(particleCellY) * static_cast<size_t>(fluidGrid.cols_) +
                 static_cast<size_t>(particleCellX);
-            fluidGrid[cellIndex].emplace_back(static_cast<FluidType>(t), static_cast<u32>(pIdx));
+            fluidGrid.buckets_[cellIndex].emplace_back(static_cast<FluidType>(t),
+                                                       static_cast<u32>(pIdx));
         }
     }
-}
\ No newline at end of file
+
+    // Occupancy stats for tuning the broadphase cell size
+    u32 occupied = 0;
+    u32 maxPerBucket = 0;
+    u32 bucketed = 0;
+    for (const auto& bucket : fluidGrid.buckets_) {
+        if (bucket.empty())
+            continue;
+        const u32 count = static_cast<u32>(bucket.size());
+        ++occupied;
+        bucketed += count;
+        maxPerBucket = (std::max)(maxPerBucket, count);
+    }
+
+    broadphaseStats.cellSize_ = fluidGrid.cellSize_;
+    broadphaseStats.cols_ = fluidGrid.cols_;
+    broadphaseStats.rows_ = fluidGrid.rows_;
+    broadphaseStats.occupiedBuckets_ = occupied;
+    broadphaseStats.maxPerBucket_ = maxPerBucket;
+    broadphaseStats.avgPerOccupied_ =
+        occupied ? static_cast<f32>(bucketed) / static_cast<f32>(occupied) : 0.0f;
+    broadphaseStats.outOfGridParticles_ = outOfGrid;
+}
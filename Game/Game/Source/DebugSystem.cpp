@@ -25,7 +25,7 @@
 
 // Project
 #include "Collectible.h"
-#include "CollisionSystem.h"
+#include "CollisionContext.h"
 #include "Components.h"
 #include "ConfigManager.h"
 #include "FluidSystem.h"
@@ -115,7 +115,14 @@ void DebugSystem::initFromJson(const std::string& file, const std::string& secti
         t.checkbox_.updateTransform();
 
         const Json::Value& entry = g_configManager.getSection("debug_system_buttons", key);
-        t.hudFormat_ = entry.get("hudFormat", "").asString();
+        // A toggle shows either a single "hudFormat" line keyed by the toggle itself, or a
+        // "hudLines" array of {value, format} pairs for multi-value readouts.
+        const std::string hudFormat = entry.get("hudFormat", "").asString();
+        if (!hudFormat.empty())
+            t.hudLines_.push_back({key, hudFormat});
+        for (const Json::Value& line : entry["hudLines"]) {
+            t.hudLines_.push_back({line["value"].asString(), line["format"].asString()});
+        }
         t.label_.content_ = entry["content"].asString();
         t.label_.r_ = entry["red"].asFloat();
         t.label_.g_ = entry["green"].asFloat();
@@ -164,6 +171,9 @@ void DebugSystem::unload() {
     for (auto& t : toggles_)
         t.checkbox_.unload();
     toggles_.clear();
+
+    if (statsDumpFile_.is_open())
+        statsDumpFile_.close();
 }
 
 // =========================================================
@@ -313,18 +323,18 @@ void DebugSystem::drawHUD() {
     if (font_ == 0 || hudMesh_ == nullptr)
         return;
 
-    // Count the number of active HUD lines (toggles that are on and have a hudFormat)
+    // Count the number of active HUD lines (toggles that are on and have HUD lines)
     int lineCount = 0;
     for (const auto& t : toggles_) {
-        if (!t.hudFormat_.empty() && options_.count(t.key_) && options_.at(t.key_))
-            lineCount++;
+        if (options_.count(t.key_) && options_.at(t.key_))
+            lineCount += static_cast<int>(t.hudLines_.size());
     }
     if (lineCount == 0)
         return;
 
     const f32 padding = 10.0f;
     const f32 lineHeight = 26.0f;
-    const f32 boxWidth = 240.0f;
+    const f32 boxWidth = 300.0f;
     const f32 textScale = 0.45f;
 
     f32 boxHeight = padding * 2.0f + lineHeight * static_cast<f32>(lineCount);
@@ -356,14 +366,16 @@ void DebugSystem::drawHUD() {
 
     AEGfxSetRenderMode(AE_GFX_RM_COLOR);
     for (const auto& t : toggles_) {
-        if (t.hudFormat_.empty() || !options_.count(t.key_) || !options_.at(t.key_)) {
+        if (t.hudLines_.empty() || !options_.count(t.key_) || !options_.at(t.key_)) {
             continue;
         }
 
-        float val = values.count(t.key_) ? values.at(t.key_) : 0.f;
-        snprintf(buf, sizeof(buf), t.hudFormat_.c_str(), val);
-        AEGfxPrint(font_, buf, textX, textY, textScale, 1.f, 1.f, 1.f, 1.f);
-        textY -= step;
+        for (const auto& line : t.hudLines_) {
+            float val = values.count(line.valueKey_) ? values.at(line.valueKey_) : 0.f;
+            snprintf(buf, sizeof(buf), line.format_.c_str(), val);
+            AEGfxPrint(font_, buf, textX, textY, textScale, 1.f, 1.f, 1.f, 1.f);
+            textY -= step;
+        }
     }
 }
 
@@ -375,12 +387,10 @@ void DebugSystem::drawHUD() {
 // them each frame for collider and velocity visualisation.
 //
 // =========================================================
-void DebugSystem::setScene(Terrain* dirt, Terrain* stone, Terrain* magic, FluidSystem* fluidSystem,
+void DebugSystem::setScene(Terrain* terrain, FluidSystem* fluidSystem,
                            CollectibleSystem* collectibles, PortalSystem* portals,
                            StartEndPoint* startEnd, VFXSystem* vfx) {
-    dirt_ = dirt;
-    stone_ = stone;
-    magic_ = magic;
+    terrain_ = terrain;
     fluidSystem_ = fluidSystem;
     collectibles_ = collectibles;
     portals_ = portals;
@@ -396,7 +406,7 @@ void DebugSystem::setScene(Terrain* dirt, Terrain* stone, Terrain* magic, FluidS
 //
 // =========================================================
 void DebugSystem::clearScene() {
-    dirt_ = stone_ = magic_ = nullptr;
+    terrain_ = nullptr;
     fluidSystem_ = nullptr;
     collectibles_ = nullptr;
     portals_ = nullptr;
@@ -408,7 +418,8 @@ void DebugSystem::clearScene() {
 //
 // DebugSystem::drawAll
 //
-// Updates HUD values, applies the UnlimitedWater toggle,
+// Updates HUD values (resetting the per-frame collision and
+// terrain edit counters), applies the UnlimitedWater toggle,
 // runs all collider and velocity visualisations for every
 // registered scene system, then draws the overlay and HUD.
 //
@@ -421,11 +432,27 @@ void DebugSystem::drawAll() {
         }
     }
     hudValues_["ShowFluidParticleCount"] = static_cast<float>(totalFluidParticles);
+    hudValues_["FluidCulledLastFrame"] =
+        fluidSystem_ ? static_cast<float>(fluidSystem_->getCulledLastFrame()) : 0.0f;
+    hudValues_["FluidCulledTotal"] =
+        fluidSystem_ ? static_cast<float>(fluidSystem_->getCulledTotal()) : 0.0f;
     hudValues_["ShowVfxParticleCount"] =
         vfx_ ? static_cast<float>(vfx_->getActiveParticleCount()) : 0.0f;
-    hudValues_["ShowCollisionCount"] =
-        static_cast<float>(CollisionSystem::getLastFrameCollisionCount());
-    CollisionSystem::resetCollisionCount();
+
+    if (fluidSystem_)
+        updateCollisionStats(fluidSystem_->getCollisionContext());
+
+    if (terrain_) {
+        const TerrainEditStats& edits = terrain_->getEditStats();
+        hudValues_["TerrainEditsQueued"] = static_cast<float>(edits.editsQueued_);
+        hudValues_["TerrainRebuilds"] = static_cast<float>(edits.rebuilds_);
+        hudValues_["TerrainCellsRebuilt"] = static_cast<float>(edits.cellsRebuilt_);
+        hudValues_["TerrainRebuildMs"] = edits.rebuildTimeMs_;
+        hudValues_["TerrainInitCellsMs"] = terrain_->getInitCellsTimeMs();
+        hudValues_["TerrainCellStorageKB"] =
+            static_cast<float>(terrain_->getCellStorageBytes()) / 1024.0f;
+        terrain_->resetEditStats();
+    }
 
     if (startEnd_) {
         const bool unlimitedWater =
@@ -436,12 +463,8 @@ void DebugSystem::drawAll() {
         }
     }
 
-    if (dirt_)
-        drawTerrainColliders(*dirt_);
-    if (stone_)
-        drawTerrainColliders(*stone_);
-    if (magic_)
-        drawTerrainColliders(*magic_);
+    if (terrain_)
+        drawTerrainColliders(*terrain_);
     if (fluidSystem_)
         drawFluidColliders(*fluidSystem_);
     if (fluidSystem_)
@@ -459,6 +482,60 @@ void DebugSystem::drawAll() {
     drawHUD();
 }
 
+// =========================================================
+//
+// DebugSystem::updateCollisionStats
+//
+// Copies the registered world's per-frame collision and
+// broadphase stats into hudValues_, appends them to the stats
+// dump while DumpCollisionStats is on, then resets them.
+//
+// =========================================================
+void DebugSystem::updateCollisionStats(CollisionContext& context) {
+    const CollisionStats& collision = context.frameStats_;
+    hudValues_["CollisionTotal"] = static_cast<float>(collision.totalHits());
+    hudValues_["CollisionPairsTested"] = static_cast<float>(collision.fluidPairsTested_);
+    hudValues_["CollisionPairsResolved"] = static_cast<float>(collision.fluidPairsResolved_);
+    hudValues_["CollisionCellsTested"] = static_cast<float>(collision.terrainCellsTested_);
+    hudValues_["CollisionCellsHit"] = static_cast<float>(collision.terrainCellsHit_);
+    hudValues_["CollisionWarmStartHits"] = static_cast<float>(collision.terrainWarmStartHits_);
+    hudValues_["CollisionPortalChecks"] =
+        static_cast<float>(collision.triggerChecks_[static_cast<int>(TriggerSystem::Portal)]);
+    hudValues_["CollisionMossChecks"] =
+        static_cast<float>(collision.triggerChecks_[static_cast<int>(TriggerSystem::Moss)]);
+    hudValues_["CollisionMossHits"] =
+        static_cast<float>(collision.triggerHits_[static_cast<int>(TriggerSystem::Moss)]);
+    hudValues_["CollisionCollectibleChecks"] =
+        static_cast<float>(collision.triggerChecks_[static_cast<int>(TriggerSystem::Collectible)]);
+    hudValues_["CollisionFlowerChecks"] =
+        static_cast<float>(collision.triggerChecks_[static_cast<int>(TriggerSystem::EndPoint)]);
+    hudValues_["CollisionGridBuildMs"] = collision.gridBuildTimeMs_;
+
+    // Machine-readable capture: one JSON line per frame while the toggle is on
+    const bool dumpStats =
+        options_.count("DumpCollisionStats") && options_.at("DumpCollisionStats");
+    if (dumpStats) {
+        if (!statsDumpFile_.is_open()) {
+            statsDumpFile_.open("collision_stats.jsonl", std::ios::out | std::ios::app);
+            statsDumpFrame_ = 0;
+        }
+        if (statsDumpFile_)
+            context.writeFrameStats(statsDumpFile_, statsDumpFrame_++);
+    } else if (statsDumpFile_.is_open()) {
+        statsDumpFile_.close();
+    }
+
+    const BroadphaseStats& broadphase = context.broadphaseStats_;
+    hudValues_["BroadphaseCellSize"] = broadphase.cellSize_;
+    hudValues_["BroadphaseBuckets"] = static_cast<float>(broadphase.cols_ * broadphase.rows_);
+    hudValues_["BroadphaseOccupied"] = static_cast<float>(broadphase.occupiedBuckets_);
+    hudValues_["BroadphaseMaxPerBucket"] = static_cast<float>(broadphase.maxPerBucket_);
+    hudValues_["BroadphaseAvgPerBucket"] = broadphase.avgPerOccupied_;
+    hudValues_["BroadphaseOutOfGrid"] = static_cast<float>(broadphase.outOfGridParticles_);
+
+    context.resetFrameStats();
+}
+
 // =========================================================
 //
 // DebugSystem::drawSingleCollider
@@ -533,8 +610,8 @@ void DebugSystem::drawPortalColliders(PortalSystem& system) {
     AEGfxSetTransparency(1.0f);
     AEGfxSetColorToMultiply(0.0f, 1.0f, 0.0f, 1.0f);
 
-    for (const Portal* p : system.getPortals()) {
-        drawSingleCollider(p->transform_, p->collider_);
+    for (const Portal& p : system.getPortals()) {
+        drawSingleCollider(p.transform_, p.collider_);
     }
 }
 
@@ -578,52 +655,72 @@ void DebugSystem::drawTerrainColliders(Terrain& terrain) {
     AEGfxSetTransparency(1.0f);
     AEGfxSetColorToMultiply(0.0f, 1.0f, 0.0f, 1.0f); // bright green
 
+    // Terrain colliders, only allocated chunks can hold any
+    for (u32 chunkRow = 0; chunkRow < terrain.getChunkRows(); ++chunkRow) {
+        for (u32 chunkCol = 0; chunkCol < terrain.getChunkCols(); ++chunkCol) {
+            if (!terrain.isChunkAllocated(chunkRow, chunkCol))
+                continue;
+
+            const GridRegion cells = terrain.getChunkCellRegion(chunkRow, chunkCol);
+            for (u32 r = cells.minRow_; r <= cells.maxRow_; ++r) {
+                for (u32 c = cells.minCol_; c <= cells.maxCol_; ++c) {
+                    const size_t cellIndex = static_cast<size_t>(r) * terrain.getCellCols() + c;
+                    if (terrain.cellHasColliders(cellIndex))
+                        drawCellColliders(terrain.getCell(cellIndex));
+                }
+            }
+        }
+    }
+}
+
+// =========================================================
+//
+// DebugSystem::drawCellColliders
+//
+// Draws the wireframe of every box and triangle collider
+// of a single terrain cell.
+//
+// =========================================================
+void DebugSystem::drawCellColliders(const Cell& cell) {
     AEMtx33 scale, rot, trans, world;
 
-    // Terrain colliders
-    const auto& cells = terrain.getCells();
-    for (const auto& cell : cells) {
-        for (int i = 0; i < 3; ++i) {
-            const Collider2D& col = cell.colliders_[i];
-            if (col.colliderShape_ == ColliderShape::Empty)
-                continue;
+    for (int i = 0; i < 3; ++i) {
+        const Collider2D& col = cell.colliders_[i];
+        if (col.colliderShape_ == ColliderShape::Empty)
+            continue;
 
-            if (col.colliderShape_ == ColliderShape::Box) {
-                const AEVec2 worldCenter{cell.transform_.pos_.x + col.shapeData_.box_.offset_.x *
-                                                                      cell.transform_.scale_.x,
-                                         cell.transform_.pos_.y + col.shapeData_.box_.offset_.y *
-                                                                      cell.transform_.scale_.y};
-                const AEVec2 worldSize{col.shapeData_.box_.size_.x * cell.transform_.scale_.x,
-                                       col.shapeData_.box_.size_.y * cell.transform_.scale_.y};
-                AEMtx33Scale(&scale, worldSize.x, worldSize.y);
-                AEMtx33Trans(&trans, worldCenter.x, worldCenter.y);
-                AEMtx33Concat(&world, &trans, &scale);
+        if (col.colliderShape_ == ColliderShape::Box) {
+            const AEVec2 worldCenter{cell.pos_.x + col.shapeData_.box_.offset_.x * cell.size_,
+                                     cell.pos_.y + col.shapeData_.box_.offset_.y * cell.size_};
+            const AEVec2 worldSize{col.shapeData_.box_.size_.x * cell.size_,
+                                   col.shapeData_.box_.size_.y * cell.size_};
+            AEMtx33Scale(&scale, worldSize.x, worldSize.y);
+            AEMtx33Trans(&trans, worldCenter.x, worldCenter.y);
+            AEMtx33Concat(&world, &trans, &scale);
+            AEGfxSetTransform(world.m);
+            AEGfxMeshDraw(wireRectMesh_, AE_GFX_MDM_LINES_STRIP);
+
+        } else if (col.colliderShape_ == ColliderShape::Triangle) {
+            AEVec2 verts[3];
+            for (int v = 0; v < 3; ++v) {
+                const AEVec2& tableVertex = col.shapeData_.triangle_.vertices_[v];
+                const AEVec2 local = MarchingSquares::placeVertex(tableVertex, cell.edges_);
+                verts[v] = {local.x * cell.size_ + cell.pos_.x, local.y * cell.size_ + cell.pos_.y};
+            }
+            for (int e = 0; e < 3; ++e) {
+                const AEVec2& a = verts[e];
+                const AEVec2& b = verts[(e + 1) % 3];
+                const f32 dx = b.x - a.x, dy = b.y - a.y;
+                const f32 len = std::sqrt(dx * dx + dy * dy);
+                if (len < 0.001f)
+                    continue;
+                AEMtx33Scale(&scale, len, 1.0f);
+                AEMtx33Rot(&rot, std::atan2(dy, dx));
+                AEMtx33Trans(&trans, a.x, a.y);
+                AEMtx33Concat(&world, &rot, &scale);
+                AEMtx33Concat(&world, &trans, &world);
                 AEGfxSetTransform(world.m);
-                AEGfxMeshDraw(wireRectMesh_, AE_GFX_MDM_LINES_STRIP);
-
-            } else if (col.colliderShape_ == ColliderShape::Triangle) {
-                AEVec2 verts[3];
-                for (int v = 0; v < 3; ++v) {
-                    verts[v] = {col.shapeData_.triangle_.vertices_[v].x * cell.transform_.scale_.x +
-                                    cell.transform_.pos_.x,
-                                col.shapeData_.triangle_.vertices_[v].y * cell.transform_.scale_.y +
-                                    cell.transform_.pos_.y};
-                }
-                for (int e = 0; e < 3; ++e) {
-                    const AEVec2& a = verts[e];
-                    const AEVec2& b = verts[(e + 1) % 3];
-                    const f32 dx = b.x - a.x, dy = b.y - a.y;
-                    const f32 len = std::sqrt(dx * dx + dy * dy);
-                    if (len < 0.001f)
-                        continue;
-                    AEMtx33Scale(&scale, len, 1.0f);
-                    AEMtx33Rot(&rot, std::atan2(dy, dx));
-                    AEMtx33Trans(&trans, a.x, a.y);
-                    AEMtx33Concat(&world, &rot, &scale);
-                    AEMtx33Concat(&world, &trans, &world);
-                    AEGfxSetTransform(world.m);
-                    AEGfxMeshDraw(wireLineMesh_, AE_GFX_MDM_LINES_STRIP);
-                }
+                AEGfxMeshDraw(wireLineMesh_, AE_GFX_MDM_LINES_STRIP);
             }
         }
     }
@@ -15,7 +15,8 @@
                   with transform, physics, and collider components.
                 - FluidSystem, a manager class that handles the initialization,
                   spawning, physics updates, and rendering for all active
-                  fluid particle pools.
+                  fluid particle pools, and runs the single trigger pass of
+                  the gameplay systems.
 
 @copyright  Copyright (C) 2026 DigiPen Institute of Technology.
             Reproduction or disclosure of this file or its contents
@@ -31,6 +32,8 @@
 #include "FluidSystem.h"
 
 // Standard library
+#include <algorithm>
+#include <cfloat>
 #include <cmath>
 #include <iostream>
 
@@ -137,6 +140,14 @@ void FluidSystem::initialize() {
         g_configManager.getAEVec2("FluidSystem", "Lava", "velocity", AEVec2{0.0f, 0.0f}),
         FluidType::Lava);
 
+    broadphaseCellSize_ = g_configManager.getFloat("FluidSystem", "Broadphase", "cellSize", 0.0f);
+
+    cullingEnabled_ = g_configManager.getBool("FluidSystem", "Culling", "enabled", true);
+    boundsMargin_ = g_configManager.getFloat("FluidSystem", "Culling", "boundsMargin", 200.0f);
+    killPlaneOffset_ =
+        g_configManager.getFloat("FluidSystem", "Culling", "killPlaneOffset", 40.0f);
+    refundCulledWater_ = g_configManager.getBool("FluidSystem", "Culling", "refundToPipe", false);
+
     // Initialize graphics for each fluid type
     // 3 Layers per particle to make our particles look more like water visually. (white, light
     // blue, dark blue)
@@ -161,21 +172,16 @@ void FluidSystem::initialize() {
 //
 // - Updates the transform matrices for every particle in an inputted
 //   particle pool.
+// - Particles are unrotated circles with a uniform scale (their
+//   diameter), so the matrix is written in one step without any trig.
+//   Every particle moves each frame, so there is nothing to cache.
 //
 // =================================================================
 void FluidSystem::updateTransforms(std::vector<FluidParticle>& particlePool) {
 
     for (auto& p : particlePool) {
-
-        AEMtx33 scale, rot, trans;
-
-        AEMtx33Scale(&scale, p.transform_.scale_.x, p.transform_.scale_.y);
-        AEMtx33Rot(&rot, p.transform_.rotationRad_);
-        AEMtx33Trans(&trans, p.transform_.pos_.x, p.transform_.pos_.y);
-
-        // worldMtx = trans * rot * scale
-        AEMtx33Concat(&p.transform_.worldMtx_, &rot, &scale);
-        AEMtx33Concat(&p.transform_.worldMtx_, &trans, &p.transform_.worldMtx_);
+        // worldMtx = trans * scale
+        composeWorldMtx(p.transform_.worldMtx_, p.transform_.pos_, p.transform_.scale_.x);
     }
 }
 
@@ -322,13 +328,59 @@ void FluidSystem::updatePortalIframes(f32 dt, std::vector<FluidParticle>& partic
     }
 }
 
+// =========================================================
+//
+// FluidSystem's out-of-bounds culling function
+//
+// Reclaims particles that escaped the world so they stop being
+// simulated, drawn and checked by every trigger system
+// - Removes particles outside the side/top bounds or below the kill plane
+// - Records culled particles against their source start point for refunds
+//
+// =========================================================
+void FluidSystem::cullOutOfBounds(std::vector<FluidParticle>& particlePool,
+                                  const AEVec2& boundsMin, const AEVec2& boundsMax) {
+    // Single pass compaction: survivors are shifted down in their original order and the
+    // culled tail is erased once, instead of one erase (and shift) per culled particle.
+    size_t writeIndex = 0;
+    for (size_t readIndex = 0; readIndex < particlePool.size(); ++readIndex) {
+        FluidParticle& p = particlePool[readIndex];
+        const AEVec2& pos = p.transform_.pos_;
+
+        const bool outOfBounds = pos.x < boundsMin.x || pos.x > boundsMax.x ||
+                                 pos.y < boundsMin.y || pos.y > boundsMax.y;
+        if (!outOfBounds) {
+            if (writeIndex != readIndex)
+                particlePool[writeIndex] = particlePool[readIndex];
+            ++writeIndex;
+            continue;
+        }
+
+        // Remember which pipe this water came from so it can be refunded
+        if (refundCulledWater_ && p.sourceIndex_ >= 0) {
+            const size_t source = static_cast<size_t>(p.sourceIndex_);
+            if (culledBySource_.size() <= source)
+                culledBySource_.resize(source + 1, 0);
+            ++culledBySource_[source];
+        }
+    }
+
+    const u32 culled = static_cast<u32>(particlePool.size() - writeIndex);
+    culledLastFrame_ += culled;
+    culledTotal_ += culled;
+    particlePool.erase(particlePool.begin() + static_cast<std::ptrdiff_t>(writeIndex),
+                       particlePool.end());
+}
+
 // =========================================================
 //
 //  FluidSystem's Main Update function
 //
 // Main update loop for the fluid simulation
+// - Commits each terrain's queued edits so collision sees this frame's cells
 // - Divides the frame delta time into smaller substeps for physics stability
 // - Updates particle physics and processes terrain collisions per substep
+// - Culls particles that escaped the world bounds or fell below the kill plane
 // - Updates final graphical transforms and portal iframes once per frame
 //
 // =========================================================
@@ -338,6 +390,11 @@ void FluidSystem::update(f32 dt, std::initializer_list<Terrain*> terrains) {
         dt = 0.016f;
     }
 
+    // Terrain edits made this frame are rebuilt once, before any substep reads the cells
+    for (Terrain* terrain : terrains) {
+        terrain->commitEdits();
+    }
+
     // Substeps
     const int subSteps = 4;
     const f32 subDt = dt / (f32)subSteps;
@@ -358,6 +415,33 @@ void FluidSystem::update(f32 dt, std::initializer_list<Terrain*> terrains) {
         }
     }
 
+    // Out-of-bounds culling: the world is the union of all terrains, with a margin around the
+    // sides and top and a kill plane just below the bottom edge.
+    culledLastFrame_ = 0;
+    if (cullingEnabled_ && terrains.size() > 0) {
+        AEVec2 boundsMin{FLT_MAX, FLT_MAX};
+        AEVec2 boundsMax{-FLT_MAX, -FLT_MAX};
+        for (Terrain* terrain : terrains) {
+            const AEVec2 bottomLeft = terrain->getBottomLeftPos();
+            const f32 cellSize = static_cast<f32>(terrain->getCellSize());
+            const f32 width = cellSize * static_cast<f32>(terrain->getCellCols());
+            const f32 height = cellSize * static_cast<f32>(terrain->getCellRows());
+            boundsMin.x = (std::min)(boundsMin.x, bottomLeft.x);
+            boundsMin.y = (std::min)(boundsMin.y, bottomLeft.y);
+            boundsMax.x = (std::max)(boundsMax.x, bottomLeft.x + width);
+            boundsMax.y = (std::max)(boundsMax.y, bottomLeft.y + height);
+        }
+        boundsMin.x -= boundsMargin_;
+        boundsMax.x += boundsMargin_;
+        boundsMax.y += boundsMargin_;
+        boundsMin.y -= killPlaneOffset_;
+
+        for (int i = 0; i < (int)FluidType::Count; i++) {
+            if (!particlePools_[i].empty())
+                cullOutOfBounds(particlePools_[i], boundsMin, boundsMax);
+        }
+    }
+
     // Final per-frame updates
     for (int i = 0; i < (int)FluidType::Count; i++) {
         if (particlePools_[i].empty()) {
@@ -484,6 +568,11 @@ void FluidSystem::free() {
     for (int i = 0; i < (int)FluidType::Count; ++i) {
         particlePools_[i].clear();
     }
+    triggerRegistry_.clear();
+
+    culledLastFrame_ = 0;
+    culledTotal_ = 0;
+    culledBySource_.clear();
 }
 
 // =========================================================
@@ -493,13 +582,18 @@ void FluidSystem::free() {
 // Instantiates and spawns a new fluid particle
 // - Creates a particle with the specified position, size, and type
 // - Assigns the appropriate pre-initialized physics configuration
+// - Tags the particle with the start point that emitted it, if any
 // - Pushes the new particle into the corresponding fluid pool
 //
 // =========================================================
-void FluidSystem::spawnParticle(f32 posX, f32 posY, f32 radius, FluidType type) {
+void FluidSystem::spawnParticle(f32 posX, f32 posY, f32 radius, FluidType type,
+                                s32 sourceIndex) {
     int i = (int)type;
     FluidParticle newParticle(posX, posY, radius, type);
     newParticle.physics_ = physicsConfigs_[i];
+    newParticle.sourceIndex_ = sourceIndex;
+    maxColliderRadius_ =
+        (std::max)(maxColliderRadius_, newParticle.collider_.shapeData_.circle_.radius_);
     particlePools_[i].push_back(newParticle);
 }
 
@@ -526,3 +620,120 @@ u32 FluidSystem::getParticleCount(FluidType type) {
 std::vector<FluidParticle>& FluidSystem::getParticlePool(FluidType type) {
     return particlePools_[(int)type];
 }
+
+// =========================================================
+//
+//  Fluidsystem's batched particle removal function
+//
+// Removes a set of particles from one pool in a single pass
+// - Sorts and de-duplicates the indices, then compacts the survivors
+//   forward and erases the tail once
+// - Keeps the survivors in their original order
+//
+// =========================================================
+void FluidSystem::removeParticles(FluidType type, std::vector<u32>& indices) {
+    if (indices.empty())
+        return;
+
+    std::vector<FluidParticle>& particlePool = particlePools_[(int)type];
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+    size_t writeIndex = indices.front();
+    size_t next = 0;
+    for (size_t readIndex = indices.front(); readIndex < particlePool.size(); ++readIndex) {
+        if (next < indices.size() && indices[next] == readIndex) {
+            ++next;
+            continue;
+        }
+        particlePool[writeIndex++] = std::move(particlePool[readIndex]);
+    }
+    particlePool.erase(particlePool.begin() + static_cast<std::ptrdiff_t>(writeIndex),
+                       particlePool.end());
+}
+
+// =========================================================
+//
+//  Fluidsystem's broadphase cell size getter function
+//
+// Retrieves the bucket size used by the fluid broadphase grid
+// - Uses the configured size when one is set in FluidSystem.json
+// - Otherwise derives it from the largest particle interaction radius
+// - Never returns less than the largest contact distance between two particles
+//
+// =========================================================
+f32 FluidSystem::getBroadphaseCellSize() const {
+    // Fallback so an empty system still produces a valid grid
+    const f32 kMinCellSize = 4.0f;
+
+    // Two particles touch when their centres are closer than the sum of their radii
+    const f32 interactionDistance = maxColliderRadius_ * 2.0f;
+
+    return (std::max)({broadphaseCellSize_, interactionDistance, kMinCellSize});
+}
+
+// =========================================================
+//
+//  Fluidsystem's culled particle count getter functions
+//
+// Retrieves how many particles were reclaimed by the world bounds
+// and kill plane in the last update, and since the system was freed
+//
+// =========================================================
+u32 FluidSystem::getCulledLastFrame() const { return culledLastFrame_; }
+
+u32 FluidSystem::getCulledTotal() const { return culledTotal_; }
+
+// =========================================================
+//
+//  Fluidsystem's culled particle refund function
+//
+// Hands back the number of culled particles that were emitted by a
+// start point, so their water can be returned to that pipe
+// - Clears the pending count so each particle is refunded only once
+//
+// =========================================================
+u32 FluidSystem::takeCulledFromSource(s32 sourceIndex) {
+    if (sourceIndex < 0 || static_cast<size_t>(sourceIndex) >= culledBySource_.size())
+        return 0;
+
+    const u32 count = culledBySource_[static_cast<size_t>(sourceIndex)];
+    culledBySource_[static_cast<size_t>(sourceIndex)] = 0;
+    return count;
+}
+
+// =========================================================
+//
+//  Fluidsystem's collision context getter functions
+//
+// Retrieves the collision scratch buffers and per-frame stats owned
+// by this simulation world
+//
+// =========================================================
+CollisionContext& FluidSystem::getCollisionContext() { return collisionContext_; }
+
+const CollisionContext& FluidSystem::getCollisionContext() const { return collisionContext_; }
+
+// =========================================================
+//
+//  Fluidsystem's trigger registry getter function
+//
+// Retrieves the registry the gameplay systems add their trigger
+// volumes to
+//
+// =========================================================
+TriggerRegistry& FluidSystem::getTriggerRegistry() { return triggerRegistry_; }
+
+// =========================================================
+//
+//  Fluidsystem's trigger dispatch function
+//
+// Runs the single trigger pass over the water pool
+// - Volumes are bucketed with the collision grid's layout, so the
+//   pass needs no extra sizing of its own
+//
+// =========================================================
+void FluidSystem::dispatchTriggers() {
+    triggerRegistry_.dispatch(*this, collisionContext_.fluidGrid_, maxColliderRadius_,
+                              collisionContext_.frameStats_);
+}
@@ -21,9 +21,11 @@
 // ============================
 // Standard library
 // ============================
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <utility>
 
 // ============================
 // Third-party
@@ -39,6 +41,82 @@
 
 LevelManager levelManager;
 
+namespace {
+// Level file layer name of each terrain material
+constexpr std::pair<TerrainMaterial, const char*> kTerrainLayers[]{
+    {TerrainMaterial::Dirt, "Dirt"},
+    {TerrainMaterial::Stone, "Stone"},
+    {TerrainMaterial::Magic, "Magic"},
+};
+
+constexpr char kHexDigits[]{"0123456789abcdef"};
+
+// Level file layer name of the node densities, saved only with densities enabled
+constexpr char kDensityLayer[]{"Density"};
+
+// Value of one hex digit, -1 if the character is not one
+int hexDigitValue(char ch) {
+    if (ch >= '0' && ch <= '9')
+        return ch - '0';
+    if (ch >= 'a' && ch <= 'f')
+        return ch - 'a' + 10;
+    if (ch >= 'A' && ch <= 'F')
+        return ch - 'A' + 10;
+    return -1;
+}
+
+// Packs a node layer into a hex string, 4 nodes per digit: bit j of digit k is node 4k + j
+std::string packTerrainLayer(const std::vector<float>& nodes) {
+    std::string packed((nodes.size() + 3) / 4, '0');
+    for (size_t k = 0; k < packed.size(); ++k) {
+        int digit = 0;
+        for (size_t j = 0; j < 4 && k * 4 + j < nodes.size(); ++j) {
+            if (nodes[k * 4 + j] >= 1.0f)
+                digit |= 1 << j;
+        }
+        packed[k] = kHexDigits[digit];
+    }
+    return packed;
+}
+
+// Expands a packed hex layer into the float array (1.0 = filled). Returns false on a bad digit.
+bool unpackTerrainLayer(const std::string& packed, std::vector<float>& nodes) {
+    for (size_t k = 0; k < packed.size(); ++k) {
+        const int digit = hexDigitValue(packed[k]);
+        if (digit < 0)
+            return false;
+
+        for (size_t j = 0; j < 4 && k * 4 + j < nodes.size(); ++j) {
+            nodes[k * 4 + j] = (digit >> j) & 1 ? 1.0f : 0.0f;
+        }
+    }
+    return true;
+}
+
+// Packs node densities into a hex string, 2 digits (one byte) per node
+std::string packDensityLayer(const std::vector<u8>& densities) {
+    std::string packed(densities.size() * 2, '0');
+    for (size_t i = 0; i < densities.size(); ++i) {
+        packed[i * 2] = kHexDigits[densities[i] >> 4];
+        packed[i * 2 + 1] = kHexDigits[densities[i] & 0xf];
+    }
+    return packed;
+}
+
+// Expands a packed density layer, missing nodes stay 0. Returns false on a bad digit.
+bool unpackDensityLayer(const std::string& packed, std::vector<u8>& densities) {
+    for (size_t i = 0; i < densities.size() && i * 2 + 1 < packed.size(); ++i) {
+        const int high = hexDigitValue(packed[i * 2]);
+        const int low = hexDigitValue(packed[i * 2 + 1]);
+        if (high < 0 || low < 0)
+            return false;
+
+        densities[i] = static_cast<u8>((high << 4) | low);
+    }
+    return true;
+}
+} // namespace
+
 EditorMode LevelManager::getLevelEditorMode() const { return levelEditorMode_; }
 
 void LevelManager::setLevelEditorMode(EditorMode mode) { levelEditorMode_ = mode; }
@@ -464,33 +542,42 @@ void LevelManager::createLevelData(int level, int width, int height, int tilesiz
 
 // =========================================================
 //
-// LevelManager::saveMapInfo(int width, int height, int tilesize, int portalLimit)
+// LevelManager::saveMapInfo(int width, int height, int tilesize, int portalLimit,
+//                           bool refundToPipe)
 //
 // - Writes map dimensions and portal limit into savingRoot_["Map"].
+// - Writes the refundToPipe opt-in only for levels that use it.
 // - Must be followed by writeToFile() to persist to disk.
 //
 // =========================================================
-void LevelManager::saveMapInfo(int width, int height, int tilesize, int portalLimit) {
+void LevelManager::saveMapInfo(int width, int height, int tilesize, int portalLimit,
+                               bool refundToPipe) {
     savingRoot_["Map"]["width"] = width;
     savingRoot_["Map"]["height"] = height;
     savingRoot_["Map"]["tileSize"] = tilesize;
     savingRoot_["Map"]["portalLimit"] = portalLimit;
+    if (refundToPipe)
+        savingRoot_["Map"]["refundToPipe"] = true;
 }
 
 // =========================================================
 //
-// LevelManager::saveTerrainInfo(std::vector<float>& nodes, const std::string& terrainType)
+// LevelManager::saveTerrainInfo(const Terrain& terrain)
 //
-// - Serializes the terrain node float array for the given type
-// - (e.g. "Dirt", "Stone", "Magic") into savingRoot_["Terrain"].
+// - Splits the merged terrain grid back into one layer per material
+// - and stores each as a packed hex string (4 nodes per digit), which
+// - is about 20x smaller than the float array. parseTerrainInfo reads
+// - both formats, so older level files still load.
+// - With densities enabled the node densities are stored as well, one
+// - byte (2 hex digits) per node, so soft brush edges survive a reload.
 //
 // =========================================================
-void LevelManager::saveTerrainInfo(std::vector<float>& nodes, const std::string& terrainType) {
-    Json::Value terrainJson(Json::arrayValue);
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        terrainJson.append(nodes[i]);
+void LevelManager::saveTerrainInfo(const Terrain& terrain) {
+    for (const auto& [material, name] : kTerrainLayers) {
+        savingRoot_["Terrain"][name] = packTerrainLayer(terrain.getMaterialNodes(material));
     }
-    savingRoot_["Terrain"][terrainType] = terrainJson;
+    if (terrain.isDensityEnabled())
+        savingRoot_["Terrain"][kDensityLayer] = packDensityLayer(terrain.getNodeDensities());
 }
 
 // =========================================================
@@ -605,11 +692,11 @@ void LevelManager::savePortalInfo(PortalSystem& portalSystem) {
 
     for (const auto& portal : portalSystem.getPortals()) {
         Json::Value portalJson;
-        portalJson["posX"] = portal->transform_.pos_.x;
-        portalJson["posY"] = portal->transform_.pos_.y;
-        portalJson["scaleX"] = portal->transform_.scale_.x;
-        portalJson["scaleY"] = portal->transform_.scale_.y;
-        portalJson["rotation"] = portal->transform_.rotationRad_;
+        portalJson["posX"] = portal.transform_.pos_.x;
+        portalJson["posY"] = portal.transform_.pos_.y;
+        portalJson["scaleX"] = portal.transform_.scale_.x;
+        portalJson["scaleY"] = portal.transform_.scale_.y;
+        portalJson["rotation"] = portal.transform_.rotationRad_;
 
         portalsJsonArray.append(portalJson);
     }
@@ -802,11 +889,27 @@ void LevelManager::parseMapInfo(int& width, int& height, int& tilesize, int& por
     }
 }
 
+// =========================================================
+//
+// LevelManager::parseRefundToPipe(bool fallback)
+//
+// - Returns the level's readingRoot_["Map"]["refundToPipe"] opt-in,
+// - or fallback (the FluidSystem.json value) when the level has none.
+// - getLevelData() must have been called first.
+//
+// =========================================================
+bool LevelManager::parseRefundToPipe(bool fallback) const {
+    if (readingRoot_.isMember("Map") && readingRoot_["Map"].isMember("refundToPipe"))
+        return readingRoot_["Map"]["refundToPipe"].asBool();
+    return fallback;
+}
+
 // =========================================================
 //
 // LevelManager::parseTerrainInfo(std::vector<float>& nodes, std::string terrainType)
 //
 // - Fills the nodes array with float values from readingRoot_["Terrain"][terrainType].
+// - The layer may be a float array or a packed hex string.
 // - getLevelData() must have been called first.
 //
 // =========================================================
@@ -821,6 +924,12 @@ void LevelManager::parseTerrainInfo(std::vector<float>& nodes, std::string terra
         return;
     }
     const Json::Value& nodeArray = terrain[terrainType];
+    if (nodeArray.isString()) {
+        if (!unpackTerrainLayer(nodeArray.asString(), nodes)) {
+            std::cout << "Terrain[" << terrainType << "] has an invalid packed layer\n";
+        }
+        return;
+    }
     if (!nodeArray.isArray()) {
         std::cout << "Terrain[" << terrainType << "] is not an array\n";
         return;
@@ -836,6 +945,39 @@ void LevelManager::parseTerrainInfo(std::vector<float>& nodes, std::string terra
     }
 }
 
+// =========================================================
+//
+// LevelManager::parseTerrainInfo(Terrain& terrain)
+//
+// - Reads every material layer from readingRoot_["Terrain"] and merges
+// - them into the terrain grid. Overlapping nodes keep the higher
+// - priority material. Call terrain.initCells() afterwards.
+// - If the terrain has densities enabled and the file has a density
+// - layer, it is restored too. Enable densities before calling this;
+// - without a saved layer they stay seeded from the nodes.
+//
+// =========================================================
+void LevelManager::parseTerrainInfo(Terrain& terrain) {
+    std::vector<float> layerNodes(terrain.getNodeCount(), 0.0f);
+    for (const auto& [material, name] : kTerrainLayers) {
+        std::fill(layerNodes.begin(), layerNodes.end(), 0.0f);
+        parseTerrainInfo(layerNodes, name);
+        terrain.setMaterialNodes(material, layerNodes);
+    }
+
+    if (!terrain.isDensityEnabled() || !readingRoot_.isMember("Terrain") ||
+        !readingRoot_["Terrain"].isMember(kDensityLayer))
+        return;
+
+    const Json::Value& densityLayer = readingRoot_["Terrain"][kDensityLayer];
+    std::vector<u8> densities(terrain.getNodeCount(), 0);
+    if (!densityLayer.isString() || !unpackDensityLayer(densityLayer.asString(), densities)) {
+        std::cout << "Terrain[" << kDensityLayer << "] has an invalid packed layer\n";
+        return;
+    }
+    terrain.setNodeDensities(densities);
+}
+
 // =========================================================
 //
 // LevelManager::parseStartEndInfo(StartEndPoint& startEndPointSystem)
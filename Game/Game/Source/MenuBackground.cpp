@@ -51,9 +51,7 @@ static int tileSize = 20;
 static int portalLimit = 0;
 static bool fileExist = false;
 
-static Terrain* bgDirt = nullptr;
-static Terrain* bgStone = nullptr;
-static Terrain* bgMagic = nullptr;
+static Terrain* bgTerrain = nullptr;
 static AEGfxTexture* pBgDirtTex = nullptr;
 static AEGfxTexture* pBgStoneTex = nullptr;
 static AEGfxTexture* pBgMagicTex = nullptr;
@@ -66,52 +64,6 @@ static PortalSystem bgPortalSystem;
 static VFXSystem bgVfxSystem;
 static CollectibleSystem bgCollectibleSystem;
 
-// =========================================================
-//
-// bgSpawnWater()
-//
-// - Waits for an initial delay before spawning water.
-// - Spawns up to 10 particles at each pipe start point on a timer.
-// - After all particles are spawned, waits before repeating.
-//
-// =========================================================
-static void bgSpawnWater(f32 deltaTime) {
-    static bool isWaiting = true;
-    static f32 stateTimer = 3.5f;
-    static f32 particleTimer = 0.0f;
-    static int particlesSpawned = 0;
-
-    if (isWaiting) {
-        stateTimer -= deltaTime;
-        if (stateTimer <= 0.0f) {
-            isWaiting = false;
-            particlesSpawned = 0;
-            particleTimer = 0.0f;
-        }
-    } else {
-        particleTimer -= deltaTime;
-        while (particleTimer <= 0.0f && particlesSpawned < 10) {
-            particleTimer += 0.05f;
-            particlesSpawned++;
-            for (auto& startPoint : bgStartEndPoint.startPoints_) {
-                if (startPoint.type_ == StartEndType::Pipe) {
-                    f32 randRadius = 8.0f;
-                    f32 xOffset = startPoint.transform_.pos_.x +
-                                  AERandFloat() * startPoint.transform_.scale_.x -
-                                  (startPoint.transform_.scale_.x / 2.f);
-                    f32 yOffset = startPoint.transform_.pos_.y -
-                                  (startPoint.transform_.scale_.y / 2.f) - randRadius;
-                    bgFluidSystem.spawnParticle(xOffset, yOffset, randRadius, FluidType::Water);
-                }
-            }
-        }
-        if (particlesSpawned >= 10) {
-            isWaiting = true;
-            stateTimer = 9.0f;
-        }
-    }
-}
-
 } // anonymous namespace
 
 // ==========================================
@@ -146,9 +98,6 @@ void MenuBackground::load(int backgroundLevel) {
         fileExist = false;
     }
 
-    Terrain::createMeshLibrary();
-    Terrain::createColliderLibrary();
-
     pBgDirtTex = AEGfxTextureLoad("Assets/Textures/terrain_dirt.png");
     pBgStoneTex = AEGfxTextureLoad("Assets/Textures/terrain_stone.png");
     pBgMagicTex = AEGfxTextureLoad("Assets/Textures/terrain_magic.png");
@@ -160,11 +109,12 @@ void MenuBackground::load(int backgroundLevel) {
 // MenuBackground::initialize()
 //
 // - Initializes the fluid, portal, and VFX systems.
-// - Allocates and initializes the three terrain layers (dirt, stone, magic).
+// - Allocates the terrain grid shared by dirt, stone, and magic.
 // - Parses terrain data from the level file if it exists.
-// - Initializes all terrain cells (transform, graphics, colliders).
+// - Derives the terrain cell cases from the merged nodes.
 // - Parses start/end point and portal data from the level file if it exists.
-// - Sets all pipe start points to infinite water release mode.
+// - Sets all pipe start points to infinite water release mode, emitting
+//   in bursts.
 // - Registers all systems with the debug system.
 //
 // =========================================================
@@ -173,33 +123,14 @@ void MenuBackground::initialize() {
     bgPortalSystem.initialize(portalLimit);
     bgVfxSystem.initialize(800, 20);
 
-    bgDirt =
-        new Terrain(TerrainMaterial::Dirt, pBgDirtTex, {0.0f, 0.0f}, height, width, tileSize, true);
-    bgStone = new Terrain(TerrainMaterial::Stone, pBgStoneTex, {0.0f, 0.0f}, height, width,
-                          tileSize, true);
-    bgMagic = new Terrain(TerrainMaterial::Magic, pBgMagicTex, {0.0f, 0.0f}, height, width,
-                          tileSize, false);
-
-    if (fileExist)
-        levelManager.parseTerrainInfo(bgDirt->getNodes(), "Dirt");
-    bgDirt->initCellsTransform();
-    bgDirt->initCellsGraphics();
-    bgDirt->initCellsCollider();
-    bgDirt->updateTerrain();
+    bgTerrain = new Terrain({0.0f, 0.0f}, height, width, tileSize);
+    bgTerrain->setTexture(TerrainMaterial::Dirt, pBgDirtTex);
+    bgTerrain->setTexture(TerrainMaterial::Stone, pBgStoneTex);
+    bgTerrain->setTexture(TerrainMaterial::Magic, pBgMagicTex);
 
     if (fileExist)
-        levelManager.parseTerrainInfo(bgStone->getNodes(), "Stone");
-    bgStone->initCellsTransform();
-    bgStone->initCellsGraphics();
-    bgStone->initCellsCollider();
-    bgStone->updateTerrain();
-
-    if (fileExist)
-        levelManager.parseTerrainInfo(bgMagic->getNodes(), "Magic");
-    bgMagic->initCellsTransform();
-    bgMagic->initCellsGraphics();
-    bgMagic->initCellsCollider();
-    bgMagic->updateTerrain();
+        levelManager.parseTerrainInfo(*bgTerrain);
+    bgTerrain->initCells();
 
     bgStartEndPoint.initialize();
     if (fileExist) {
@@ -212,27 +143,39 @@ void MenuBackground::initialize() {
         startPoint.releaseWater_ = true;
     }
 
-    g_debugSystem.setScene(bgDirt, bgStone, bgMagic, &bgFluidSystem, nullptr, &bgPortalSystem,
-                           &bgStartEndPoint, &bgVfxSystem);
+    // Pipes release a short burst every few seconds instead of a stream
+    PipeSchedule pipeSchedule;
+    pipeSchedule.spawnInterval_ = 0.05f;
+    pipeSchedule.particleRadius_ = 8.0f;
+    pipeSchedule.burstCount_ = 10;
+    pipeSchedule.burstPause_ = 9.0f;
+    pipeSchedule.startDelay_ = 3.5f;
+    bgStartEndPoint.setPipeSchedule(pipeSchedule);
+
+    g_debugSystem.setScene(bgTerrain, &bgFluidSystem, nullptr, &bgPortalSystem, &bgStartEndPoint,
+                           &bgVfxSystem);
 }
 
 // =========================================================
 //
 // MenuBackground::update()
 //
-// - Updates collectibles, start/end points, and water spawning.
+// - Updates collectibles and start/end points, which spawn the pipes' water.
 // - Updates the fluid simulation against the terrain layers.
 // - Updates the portal system with the current water particle pool.
+// - Runs the trigger pass for every system registered above.
 // - Updates the VFX system.
 //
 // =========================================================
 void MenuBackground::update(f32 deltaTime) {
-    bgCollectibleSystem.update(deltaTime, bgFluidSystem.getParticlePool(FluidType::Water),
-                               bgVfxSystem);
-    bgStartEndPoint.update(deltaTime, bgFluidSystem.getParticlePool(FluidType::Water), bgVfxSystem);
-    bgSpawnWater(deltaTime);
-    bgFluidSystem.update(deltaTime, {bgDirt, bgStone});
-    bgPortalSystem.update(deltaTime, bgFluidSystem.getParticlePool(FluidType::Water), bgVfxSystem);
+    // Nothing reads the menu world's collision stats, so start every frame from zero
+    bgFluidSystem.getCollisionContext().resetFrameStats();
+
+    bgCollectibleSystem.update(deltaTime, bgFluidSystem, bgVfxSystem);
+    bgStartEndPoint.update(deltaTime, bgFluidSystem, bgVfxSystem);
+    bgFluidSystem.update(deltaTime, {bgTerrain});
+    bgPortalSystem.update(deltaTime, bgFluidSystem, bgVfxSystem);
+    bgFluidSystem.dispatchTriggers();
     bgVfxSystem.update(deltaTime);
 }
 
@@ -241,7 +184,7 @@ void MenuBackground::update(f32 deltaTime) {
 // MenuBackground::draw()
 //
 // - Sets the background colour to black.
-// - Draws the tiled background, then terrain layers in order.
+// - Draws the tiled background, then the terrain material batches.
 // - Draws start/end points, portals, VFX, and fluid particles.
 //
 // =========================================================
@@ -250,9 +193,7 @@ void MenuBackground::draw() {
 
     bg.draw();
 
-    bgDirt->renderTerrain();
-    bgStone->renderTerrain();
-    bgMagic->renderTerrain();
+    bgTerrain->renderTerrain();
 
     bgStartEndPoint.drawTexture(0);
     bgPortalSystem.draw();
@@ -272,10 +213,10 @@ void MenuBackground::draw() {
 //
 // =========================================================
 bool MenuBackground::destroyDirtAtMouse(f32 radius) {
-    if (bgDirt == nullptr)
+    if (bgTerrain == nullptr)
         return false;
 
-    bool hitDirt = bgDirt->destroyAtMouse(radius);
+    bool hitDirt = bgTerrain->destroyAtMouse(TerrainMaterial::Dirt, radius);
 
     if (hitDirt) {
         bgVfxSystem.spawnContinuous(VFXType::DirtBurst, getMouseWorldPos(), 0.016f, 0.1f);
@@ -292,7 +233,7 @@ bool MenuBackground::destroyDirtAtMouse(f32 radius) {
 //
 // - Clears the debug system scene registration.
 // - Frees the fluid, start/end point, portal, and VFX systems.
-// - Deletes all three terrain layers and nulls their pointers.
+// - Deletes the terrain grid and nulls its pointer.
 //
 // =========================================================
 void MenuBackground::free() {
@@ -301,12 +242,8 @@ void MenuBackground::free() {
     bgStartEndPoint.free();
     bgPortalSystem.free();
     bgVfxSystem.free();
-    delete bgDirt;
-    bgDirt = nullptr;
-    delete bgStone;
-    bgStone = nullptr;
-    delete bgMagic;
-    bgMagic = nullptr;
+    delete bgTerrain;
+    bgTerrain = nullptr;
 }
 
 // =========================================================
@@ -328,8 +265,6 @@ void MenuBackground::unload() {
     if (loadRefCount > 0)
         return;
 
-    Terrain::freeMeshLibrary();
-
     if (pBgDirtTex) {
         AEGfxTextureUnload(pBgDirtTex);
         pBgDirtTex = nullptr;
@@ -23,7 +23,6 @@
 #include <cmath>
 
 // Project
-#include "CollisionSystem.h"
 #include "ConfigManager.h"
 #include "MouseUtils.h"
 
@@ -241,28 +240,6 @@ void MossSystem::loadLevelMoss(AEVec2 pos, MossType type) {
     m.absorptionRate_ = mossAbsorptionRate_;
 }
 
-// =========================================================
-//
-// MossSystem::checkCollisionWithWater()
-//
-// - Returns false if the moss is inactive or has no health remaining.
-// - Computes the squared distance between the particle and moss centres.
-// - Returns true if the squared distance is less than the squared sum of radii.
-//
-// =========================================================
-bool MossSystem::checkCollisionWithWater(const Moss& moss, const FluidParticle& particle) {
-    if (!moss.active_ || moss.currentHealth_ <= 0.0f)
-        return false;
-
-    AEVec2 delta = {particle.transform_.pos_.x - moss.transform_.pos_.x,
-                    particle.transform_.pos_.y - moss.transform_.pos_.y};
-
-    f32 distSq = delta.x * delta.x + delta.y * delta.y;
-    f32 radiusSum =
-        particle.collider_.shapeData_.circle_.radius_ + moss.collider_.shapeData_.circle_.radius_;
-    return distSq < (radiusSum * radiusSum);
-}
-
 // =========================================================
 //
 // MossSystem::update()
@@ -271,15 +248,17 @@ bool MossSystem::checkCollisionWithWater(const Moss& moss, const FluidParticle&
 // - Alternates mossFrame_ between 0 (idle) and 1 (bouncy) on a timer.
 // - For each active moss:
 //   - Applies a sinusoidal pulse to the scale.
-//   - Rebuilds the world transform matrix.
-//   - Checks collision against all water particles in the pool.
-//   - On collision, decrements health, spawns VFX (with cooldown),
-//     erases the particle, and deactivates the moss if health reaches zero.
+//   - Recomposes the world transform matrix in one step if the pulse
+//     moved it; the rotation's trig stays cached (see updateWorldMtx).
+//   - Registers its collider as a trigger circle, tagged with its index,
+//     for the fluid system's trigger pass (see onTriggerHits).
 //
 // =========================================================
-void MossSystem::update(f32 dt, std::vector<FluidParticle>& particlePool,
-                        StartEndPoint& startEndPointSystem, VFXSystem& vfx) {
+void MossSystem::update(f32 dt, FluidSystem& fluidSystem, StartEndPoint& startEndPointSystem,
+                        VFXSystem& vfx) {
+    TriggerRegistry& triggerRegistry = fluidSystem.getTriggerRegistry();
     (void)startEndPointSystem;
+    vfxSystem_ = &vfx;
     globalTimer_ += dt;
 
     mossFrameTimer_ += dt;
@@ -288,8 +267,7 @@ void MossSystem::update(f32 dt, std::vector<FluidParticle>& particlePool,
         mossFrame_ = (mossFrame_ == 0) ? 1 : 0;
     }
 
-    static f32 mossHitVfxCooldown = 0.0f;
-    mossHitVfxCooldown -= dt;
+    mossHitVfxCooldown_ -= dt;
 
     for (auto& m : mosses_) {
         if (!m.active_ || m.currentHealth_ <= 0.0f)
@@ -298,34 +276,47 @@ void MossSystem::update(f32 dt, std::vector<FluidParticle>& particlePool,
         m.growthTimer_ += dt * 2.0f;
         float pulse = sinf(m.growthTimer_) * 0.1f + 1.0f;
         m.transform_.scale_ = {40.0f * pulse, 40.0f * pulse};
+        updateWorldMtx(m.transform_, m.worldCache_);
+
+        triggerRegistry.addCircle(TriggerSystem::Moss, m.transform_.pos_,
+                                  m.collider_.shapeData_.circle_.radius_, this,
+                                  static_cast<u32>(&m - mosses_.data()));
+    }
+}
+
+// =========================================================
+//
+// MossSystem::onTriggerHits()
+//
+// - Called by the trigger pass with the water particles touching a moss
+//   that no earlier trigger has consumed.
+// - For each hit: decrements health, spawns VFX (with cooldown) and
+//   consumes the particle, which the pass removes in one batch.
+// - Deactivates the moss once health reaches zero, leaving the rest of
+//   the particles to the triggers after it.
+//
+// =========================================================
+void MossSystem::onTriggerHits(u32 tag, const std::vector<u32>& particleIndices,
+                               TriggerRegistry& registry, FluidSystem& fluidSystem) {
+    const std::vector<FluidParticle>& particlePool = fluidSystem.getParticlePool(FluidType::Water);
+    Moss& m = mosses_[tag];
+
+    for (u32 index : particleIndices) {
+        if (!m.active_ || m.currentHealth_ <= 0.0f)
+            break;
 
-        AEMtx33 scale, rot, trans;
-        AEMtx33Scale(&scale, m.transform_.scale_.x, m.transform_.scale_.y);
-        AEMtx33Rot(&rot, m.transform_.rotationRad_);
-        AEMtx33Trans(&trans, m.transform_.pos_.x, m.transform_.pos_.y);
-        AEMtx33Concat(&m.transform_.worldMtx_, &rot, &scale);
-        AEMtx33Concat(&m.transform_.worldMtx_, &trans, &m.transform_.worldMtx_);
-
-        for (auto it = particlePool.begin(); it != particlePool.end();) {
-            if (checkCollisionWithWater(m, *it)) {
-                CollisionSystem::incrementCollisionCount();
-                m.currentHealth_ -= m.absorptionRate_;
-
-                if (mossHitVfxCooldown <= 0.0f) {
-                    vfx.spawnVFX(VFXType::LeafCollect, it->transform_.pos_);
-                    mossHitVfxCooldown = mossHitVfxCooldownMax_;
-                }
-
-                it = particlePool.erase(it);
-
-                if (m.currentHealth_ <= 0.0f) {
-                    vfx.spawnVFX(VFXType::LeafCollect, m.transform_.pos_);
-                    m.active_ = false;
-                    break;
-                }
-            } else {
-                ++it;
-            }
+        m.currentHealth_ -= m.absorptionRate_;
+
+        if (mossHitVfxCooldown_ <= 0.0f) {
+            vfxSystem_->spawnVFX(VFXType::LeafCollect, particlePool[index].transform_.pos_);
+            mossHitVfxCooldown_ = mossHitVfxCooldownMax_;
+        }
+
+        registry.consumeParticle(index);
+
+        if (m.currentHealth_ <= 0.0f) {
+            vfxSystem_->spawnVFX(VFXType::LeafCollect, m.transform_.pos_);
+            m.active_ = false;
         }
     }
 }
@@ -539,4 +530,46 @@ void MossSystem::destroyAtMousePos() {
             return;
         }
     }
-}
\ No newline at end of file
+}
+
+// =========================================================
+//
+// MossSystem::spawnStressGrid()
+//
+// - Reads the grid size and health from the "stressTest" section of
+//   moss.json (10 x 5 moss by default).
+// - Spreads the moss evenly over the given world area, each at the
+//   centre of its grid slot. Slots whose centre is on solid terrain
+//   are left empty, so no moss is buried where water cannot reach.
+// - Gives them a large health pool so they keep absorbing for the
+//   whole test instead of dying to the first wave of water.
+// - Returns the number of moss placed.
+//
+// =========================================================
+int MossSystem::spawnStressGrid(const AEVec2& bottomLeft, f32 areaWidth, f32 areaHeight,
+                                const Terrain& terrain) {
+    const int columns = g_configManager.getInt("moss", "stressTest", "columns", 10);
+    const int rows = g_configManager.getInt("moss", "stressTest", "rows", 5);
+    const float maxHealth = g_configManager.getFloat("moss", "stressTest", "maxHealth", 1000.0f);
+    if (columns <= 0 || rows <= 0)
+        return 0;
+
+    const f32 slotWidth = areaWidth / static_cast<f32>(columns);
+    const f32 slotHeight = areaHeight / static_cast<f32>(rows);
+    mosses_.reserve(mosses_.size() + static_cast<size_t>(columns) * rows);
+    int placed = 0;
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < columns; ++col) {
+            const AEVec2 pos{bottomLeft.x + (col + 0.5f) * slotWidth,
+                             bottomLeft.y + (row + 0.5f) * slotHeight};
+            if (terrain.isSolidAt(pos))
+                continue;
+
+            loadLevelMoss(pos, MossType::Spiky);
+            mosses_.back().maxHealth_ = maxHealth;
+            mosses_.back().currentHealth_ = maxHealth;
+            ++placed;
+        }
+    }
+    return placed;
+}
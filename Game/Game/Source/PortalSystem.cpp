@@ -19,6 +19,7 @@
 // =============================
 // Standard library
 // =============================
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -31,7 +32,6 @@
 // Project
 // =============================
 #include "AudioSystem.h"
-#include "CollisionSystem.h"
 #include "ConfigManager.h"
 #include "MouseUtils.h"
 
@@ -40,7 +40,7 @@
 // Portal::Portal()
 //
 // - Default constructor. Initializes transform at the origin with unit scale,
-// - sets a box collider of unit size, clears the tint color, and nulls the link.
+// - sets a box collider of unit size, clears the tint color, and clears the link.
 //
 // =========================================================
 Portal::Portal() {
@@ -62,12 +62,13 @@ Portal::Portal() {
     // Set collider
     collider_.colliderShape_ = ColliderShape::Box;
     collider_.shapeData_.box_.size_ = {1.f, 1.f};
+    halfExtents_ = {0.5f, 0.5f};
 
     red_ = 0.0f;
     green_ = 0.0f;
     blue_ = 0.0f;
 
-    linkedPortal_ = nullptr;
+    linkedIndex_ = -1;
 }
 
 // =========================================================
@@ -76,7 +77,8 @@ Portal::Portal() {
 //
 // - Constructs a portal at the given world position with a random tint color.
 // - The collider is inset to 90% of the scale to allow slight portal overlap.
-// - Rotation is stored in radians converted from the given degrees.
+// - Rotation is stored in radians converted from the given degrees, and its
+// - cosine and sine are cached with the collider's half extents.
 //
 // =========================================================
 Portal::Portal(AEVec2 pos, AEVec2 scale, f32 rotationDeg) {
@@ -99,11 +101,17 @@ Portal::Portal(AEVec2 pos, AEVec2 scale, f32 rotationDeg) {
     collider_.shapeData_.box_.size_.x = scale.x * 0.9f;
     collider_.shapeData_.box_.size_.y = scale.y * 0.9f;
 
+    // Cache the rotation and extents the trigger pass and teleports use
+    cosRotation_ = AECos(transform_.rotationRad_);
+    sinRotation_ = AESin(transform_.rotationRad_);
+    halfExtents_ = {collider_.shapeData_.box_.size_.x / 2.0f,
+                    collider_.shapeData_.box_.size_.y / 2.0f};
+
     red_ = AERandFloat();
     green_ = AERandFloat();
     blue_ = AERandFloat();
 
-    linkedPortal_ = nullptr;
+    linkedIndex_ = -1;
 }
 
 // =========================================================
@@ -126,11 +134,16 @@ void PortalSystem::initialize(int const& portalMax) {
 
     portalScale_ =
         g_configManager.getAEVec2("PortalSystem", "default", "portalScale_", AEVec2{30.f, 60.f});
+    exitSpacing_ = g_configManager.getFloat("PortalSystem", "default", "exitSpacing_", 1.0f);
     rotationValue_ = 0.0f;
-    currentPortal_ = nullptr;
+    currentPortal_ = -1;
     clickIframe_ = false;
     portalLimit_ = portalMax;
 
+    // Placing portals up to the limit never reallocates the pool
+    portals_.clear();
+    portals_.reserve(static_cast<size_t>((std::max)(portalLimit_, 0)));
+
     nextRed_ = AERandFloat();
     nextGreen_ = AERandFloat();
     nextBlue_ = AERandFloat();
@@ -140,37 +153,39 @@ void PortalSystem::initialize(int const& portalMax) {
 //
 // PortalSystem::setupPortal(AEVec2 pos, AEVec2 scale, f32 rotationDeg)
 //
-// - Allocates a new Portal and appends it to portalVec_.
+// - Appends a new Portal to the portals_ pool.
 // - The first portal of a pair is held in currentPortal_ and assigned the pending color.
-// - The second portal is linked to the first bidirectionally; both share the same tint.
+// - The second portal is linked to the first by index both ways; both share the same tint.
 // - A new random color is then queued for the next pair.
 // - Returns false without placing if the portal limit has been reached.
 //
 // =========================================================
 bool PortalSystem::setupPortal(AEVec2 pos, AEVec2 scale, f32 rotationDeg) {
     // Limit number of portals that can be placed
-    if (portalVec_.size() >= static_cast<size_t>(portalLimit_)) {
+    if (portals_.size() >= static_cast<size_t>(portalLimit_)) {
         return false;
     }
 
-    Portal* portalToAdd = new Portal(pos, scale, rotationDeg);
-    portalVec_.push_back(portalToAdd);
+    const s32 addedIndex = static_cast<s32>(portals_.size());
+    portals_.emplace_back(pos, scale, rotationDeg);
+    Portal& portalToAdd = portals_.back();
 
-    if (currentPortal_ == nullptr) {
-        currentPortal_ = portalToAdd;
-        portalToAdd->red_ = nextRed_;
-        portalToAdd->green_ = nextGreen_;
-        portalToAdd->blue_ = nextBlue_;
+    if (currentPortal_ < 0) {
+        currentPortal_ = addedIndex;
+        portalToAdd.red_ = nextRed_;
+        portalToAdd.green_ = nextGreen_;
+        portalToAdd.blue_ = nextBlue_;
     } else {
         // Link the current portal to the new portal
-        currentPortal_->linkedPortal_ = portalToAdd;
-        portalToAdd->linkedPortal_ = currentPortal_;
+        Portal& current = portals_[currentPortal_];
+        current.linkedIndex_ = addedIndex;
+        portalToAdd.linkedIndex_ = currentPortal_;
         // Set both to have same colors
-        portalToAdd->red_ = currentPortal_->red_;
-        portalToAdd->green_ = currentPortal_->green_;
-        portalToAdd->blue_ = currentPortal_->blue_;
-        // Reset currentPortal_ to nullptr to look for next unlinked portal
-        currentPortal_ = nullptr;
+        portalToAdd.red_ = current.red_;
+        portalToAdd.green_ = current.green_;
+        portalToAdd.blue_ = current.blue_;
+        // Reset currentPortal_ to -1 to look for next unlinked portal
+        currentPortal_ = -1;
 
         // Get next set of colors for the next portal pair
         nextRed_ = AERandFloat();
@@ -182,134 +197,202 @@ bool PortalSystem::setupPortal(AEVec2 pos, AEVec2 scale, f32 rotationDeg) {
 
 // =========================================================
 //
-// PortalSystem::collisionCheckWithWater(Portal portal, FluidParticle particle)
-//
-// - Rotated AABB-circle collision test.
-// - Transforms the particle position into the portal's local (unrotated) space,
-// - finds the closest point on the axis-aligned box, and checks whether
-// - the squared distance is less than the particle radius squared.
-//
-// =========================================================
-bool PortalSystem::collisionCheckWithWater(Portal portal, FluidParticle particle) {
-    // Circle to Rectangle Collision Detection
-
-    // Transform the particle position into the portal's local space
-    // Undo the portal's rotation
-    f32 cosAngle = AECos(-portal.transform_.rotationRad_);
-    f32 sinAngle = AESin(-portal.transform_.rotationRad_);
-
-    // Translate particle position to portal space
-    f32 translatedX = particle.transform_.pos_.x - portal.transform_.pos_.x;
-    f32 translatedY = particle.transform_.pos_.y - portal.transform_.pos_.y;
-
-    // Rotate the particle position into the portal's local frame
-    f32 localX = translatedX * cosAngle - translatedY * sinAngle;
-    f32 localY = translatedX * sinAngle + translatedY * cosAngle;
-
-    // Find the closest point to the circle within the rectangle
-    f32 rectHalfWidth = portal.collider_.shapeData_.box_.size_.x / 2.0f;
-    f32 rectHalfHeight = portal.collider_.shapeData_.box_.size_.y / 2.0f;
-    f32 closest_x = fmaxf(-rectHalfWidth, fminf(localX, rectHalfWidth));
-    f32 closest_y = fmaxf(-rectHalfHeight, fminf(localY, rectHalfHeight));
-
-    // Calculate the distance between the circle's center and this closest point
-    f32 distanceX = localX - closest_x;
-    f32 distanceY = localY - closest_y;
-    // If the distance is less than the circle's radius, an intersection occurs
-    f32 distance_squared = (distanceX * distanceX) + (distanceY * distanceY);
-    f32 radius = particle.collider_.shapeData_.circle_.radius_;
-
-    return distance_squared < (radius * radius);
-}
-
-// =========================================================
-//
-// PortalSystem::update(f32 dt, std::vector<FluidParticle>& particlePool, VFXSystem& vfx)
+// PortalSystem::update(f32 dt, FluidSystem& fluidSystem, VFXSystem& vfx)
 //
 // - Each frame: finds any unlinked portal to hold as currentPortal_,
-// - then checks every linked portal against every particle.
-// - On collision: maps the particle position through the entry-to-exit rotation,
-// - applies a pop-boost in the exit direction, sets a portal iframe,
-// - and spawns VFX at the exit portal on cooldown.
+// - then rebuilds the entry-to-exit transit of each linked portal and
+// - registers its rotated box as a trigger volume, tagged with its index,
+// - for the fluid system's trigger pass.
 //
 // =========================================================
-void PortalSystem::update(f32 dt, std::vector<FluidParticle>& particlePool, VFXSystem& vfx) {
+void PortalSystem::update(f32 dt, FluidSystem& fluidSystem, VFXSystem& vfx) {
+    TriggerRegistry& triggerRegistry = fluidSystem.getTriggerRegistry();
+    vfxSystem_ = &vfx;
     portalVfxCooldown_ -= dt;
     // Look for unlinked portals to set to currentPortal_
-    if (currentPortal_ == nullptr) {
-        for (auto& portal : portalVec_) {
-            if (portal->linkedPortal_ == nullptr) {
-                currentPortal_ = portal;
+    if (currentPortal_ < 0) {
+        for (size_t i = 0; i < portals_.size(); ++i) {
+            if (portals_[i].linkedIndex_ < 0) {
+                currentPortal_ = static_cast<s32>(i);
                 // std::cout << "Found unlinked portal to set as currentPortal_\n";
                 break;
             }
         }
     }
 
-    // Check
-    // for each portal with each water particle
-    for (auto& portal : portalVec_) {
+    // Register each linked portal with the trigger pass
+    transits_.resize(portals_.size());
+    for (u32 i = 0; i < static_cast<u32>(portals_.size()); ++i) {
+        const Portal& portal = portals_[i];
         // Skip if portal is not linked
-        if (portal->linkedPortal_ == nullptr) {
+        if (portal.linkedIndex_ < 0) {
             continue;
         }
-        for (auto& particle : particlePool) {
-            // Skip if particle is in iframe
-            if (particle.portalIframe_) {
-                continue;
-            }
-            if (collisionCheckWithWater(*portal, particle)) {
-                CollisionSystem::incrementCollisionCount();
-                // Teleport the particle to the linked portal's position
-                // Get relative position to entrance portal
-                f32 relativePosX = (particle.transform_.pos_.x - portal->transform_.pos_.x) /
-                                   portal->transform_.scale_.x;
-                f32 relativePosY = (particle.transform_.pos_.y - portal->transform_.pos_.y) /
-                                   portal->transform_.scale_.y;
-
-                // Rotate relative position based on portal rotations
-                f32 cosEntry = AECos(portal->transform_.rotationRad_);
-                f32 sinEntry = AESin(portal->transform_.rotationRad_);
-                f32 cosExit = AECos(portal->linkedPortal_->transform_.rotationRad_);
-                f32 sinExit = AESin(portal->linkedPortal_->transform_.rotationRad_);
-
-                // Normalize position to portal's local space
-                f32 normalizedPosX = relativePosX * cosEntry + relativePosY * sinEntry;
-                f32 normalizedPosY = -relativePosX * sinEntry + relativePosY * cosEntry;
-
-                // Adjust position to linked portal's orientation
-                f32 adjustedPosX = normalizedPosX * cosExit - normalizedPosY * sinExit;
-                f32 adjustedPosY = normalizedPosX * sinExit + normalizedPosY * cosExit;
-
-                particle.transform_.pos_.x =
-                    portal->linkedPortal_->transform_.pos_.x + adjustedPosX;
-                particle.transform_.pos_.y =
-                    portal->linkedPortal_->transform_.pos_.y + adjustedPosY;
-
-                const f32 popBoost = 50.0f;
-                f32 speed = AEVec2Length(&particle.physics_.velocity_);
-                particle.physics_.velocity_.x = speed * cosExit + (popBoost * cosExit);
-                particle.physics_.velocity_.y = speed * sinExit + (popBoost * sinExit);
-
-                //  Activate iframe to prevent immediate re-teleportation
-                particle.portalIframe_ = true;
-
-                if (portalVfxCooldown_ <= 0.0f) {
-
-                    // Spawn particles at the INPUT portal pos
-                    // vfx.spawnVFX(VFXType::PortalBurst, portal->transform_.pos_,
-                    // portal->transform_.rotationRad_);
-
-                    // Spawn the particles at the OUTPUT portal pos
-                    vfx.spawnVFX(VFXType::PortalBurst, portal->linkedPortal_->transform_.pos_,
-                                 portal->linkedPortal_->transform_.rotationRad_);
-
-                    // Lock the timer for 0.25 seconds (Only 4 bursts allowed per second)
-                    portalVfxCooldown_ = 0.25f;
-                }
-            }
+        transits_[i] = buildTransit(portal, portals_[portal.linkedIndex_]);
+        triggerRegistry.addOrientedBox(TriggerSystem::Portal, portal.transform_.pos_,
+                                       portal.halfExtents_, portal.cosRotation_,
+                                       portal.sinRotation_, this, i);
+    }
+}
+
+// =========================================================
+//
+// PortalSystem::buildTransit(const Portal& entry, const Portal& exit)
+//
+// - Resolves the teleport mapping of a linked pair from the cached
+// - cosines and sines: the entry's face axis, the ratio of the two
+// - faces, and the exit's position, face axis and exit direction.
+//
+// =========================================================
+PortalTransit PortalSystem::buildTransit(const Portal& entry, const Portal& exit) {
+    PortalTransit transit;
+    transit.entryPos_ = entry.transform_.pos_;
+    transit.entryFaceAxis_ = {-entry.sinRotation_, entry.cosRotation_};
+    transit.faceScale_ =
+        entry.halfExtents_.y > 0.0f ? exit.halfExtents_.y / entry.halfExtents_.y : 0.0f;
+    transit.exitHalfFace_ = exit.halfExtents_.y;
+
+    transit.exitPos_ = exit.transform_.pos_;
+    transit.exitDirection_ = {exit.cosRotation_, exit.sinRotation_};
+    transit.exitFaceAxis_ = {-exit.sinRotation_, exit.cosRotation_};
+    return transit;
+}
+
+// =========================================================
+//
+// PortalSystem::spreadExitRow(row, count, spacing, halfFace)
+//
+// - Takes face offsets sorted in ascending order and pushes each one at
+// - least spacing past the previous, starting from the bottom of the face.
+// - If the row then runs past the top of the face, pulls it back down
+// - from the top. The caller never passes more than fit on the face, so
+// - both passes together keep every offset on it.
+// - Offsets that are already far enough apart are left where they are.
+//
+// =========================================================
+void PortalSystem::spreadExitRow(PortalTeleport* row, size_t count, f32 spacing, f32 halfFace) {
+    row[0].faceOffset_ = (std::max)(row[0].faceOffset_, -halfFace);
+    for (size_t i = 1; i < count; ++i) {
+        row[i].faceOffset_ = (std::max)(row[i].faceOffset_, row[i - 1].faceOffset_ + spacing);
+    }
+
+    if (row[count - 1].faceOffset_ <= halfFace) {
+        return;
+    }
+    row[count - 1].faceOffset_ = halfFace;
+    for (size_t i = count - 1; i > 0; --i) {
+        row[i - 1].faceOffset_ = (std::min)(row[i - 1].faceOffset_, row[i].faceOffset_ - spacing);
+    }
+}
+
+// =========================================================
+//
+// PortalSystem::onTriggerHits(u32 tag, ...)
+//
+// - Called by the trigger pass with the water particles inside a portal,
+// - skipping particles still in their portal iframe.
+// - Teleports everything entering the portal this frame as one batch:
+//   - Each particle's offset along the entry face is scaled onto the
+//     exit face, so the stream keeps its shape.
+//   - Sorted by that offset, the particles fill rows across the exit
+//     face at least exitSpacing_ diameters apart; a batch too wide for
+//     one row continues in rows further out along the exit direction.
+// - Applies a pop-boost in the exit direction, sets a portal iframe,
+// - and spawns VFX at the exit portal on cooldown.
+// - Teleported particles carry an iframe, so portals dispatched later in
+// - the same pass skip them.
+//
+// The list of optimisations include:
+// - Particles no longer land stacked on the exit centre, which used to
+// - cost a burst of large pair pushes on the next collision pass
+// - No AECos/AESin per particle: every trig term is resolved at placement
+// - or once per frame in the transit
+// - Portals and particles are accessed by reference, never copied
+//
+// =========================================================
+void PortalSystem::onTriggerHits(u32 tag, const std::vector<u32>& particleIndices,
+                                 TriggerRegistry& registry, FluidSystem& fluidSystem) {
+    (void)registry;
+    std::vector<FluidParticle>& particlePool = fluidSystem.getParticlePool(FluidType::Water);
+    const Portal& portal = portals_[tag];
+    if (portal.linkedIndex_ < 0) {
+        return;
+    }
+    const Portal& exitPortal = portals_[portal.linkedIndex_];
+    const PortalTransit& transit = transits_[tag];
+
+    // Collect the entrants with their offsets mapped onto the exit face
+    teleportBatch_.clear();
+    f32 maxRadius = 0.0f;
+    for (u32 index : particleIndices) {
+        const FluidParticle& particle = particlePool[index];
+        // Skip if particle is in iframe
+        if (particle.portalIframe_) {
+            continue;
+        }
+        const f32 dx = particle.transform_.pos_.x - transit.entryPos_.x;
+        const f32 dy = particle.transform_.pos_.y - transit.entryPos_.y;
+        const f32 entryOffset = dx * transit.entryFaceAxis_.x + dy * transit.entryFaceAxis_.y;
+        teleportBatch_.push_back({index, entryOffset * transit.faceScale_});
+        maxRadius = (std::max)(maxRadius, particle.collider_.shapeData_.circle_.radius_);
+    }
+    if (teleportBatch_.empty()) {
+        return;
+    }
+
+    std::sort(teleportBatch_.begin(), teleportBatch_.end(),
+              [](const PortalTeleport& a, const PortalTeleport& b) {
+                  return a.faceOffset_ < b.faceOffset_;
+              });
+
+    // As many particles as fit across the exit face make up one row
+    const f32 spacing = 2.0f * maxRadius * exitSpacing_;
+    const f32 halfFace = transit.exitHalfFace_;
+    size_t rowLength = teleportBatch_.size();
+    if (spacing > 0.0f) {
+        rowLength = static_cast<size_t>(2.0f * halfFace / spacing) + 1;
+    }
+
+    const f32 popBoost = 50.0f;
+    for (size_t rowStart = 0; rowStart < teleportBatch_.size(); rowStart += rowLength) {
+        const size_t count = (std::min)(rowLength, teleportBatch_.size() - rowStart);
+        PortalTeleport* row = teleportBatch_.data() + rowStart;
+        spreadExitRow(row, count, spacing, halfFace);
+
+        // Later rows queue up further out of the exit
+        const f32 depth = static_cast<f32>(rowStart / rowLength) * spacing;
+        for (size_t i = 0; i < count; ++i) {
+            FluidParticle& particle = particlePool[row[i].particleIndex_];
+
+            // Teleport the particle to its slot at the linked portal
+            particle.transform_.pos_.x = transit.exitPos_.x + transit.exitDirection_.x * depth +
+                                         transit.exitFaceAxis_.x * row[i].faceOffset_;
+            particle.transform_.pos_.y = transit.exitPos_.y + transit.exitDirection_.y * depth +
+                                         transit.exitFaceAxis_.y * row[i].faceOffset_;
+
+            // Leave along the exit direction with a pop-boost
+            f32 speed = AEVec2Length(&particle.physics_.velocity_);
+            particle.physics_.velocity_.x = (speed + popBoost) * transit.exitDirection_.x;
+            particle.physics_.velocity_.y = (speed + popBoost) * transit.exitDirection_.y;
+
+            //  Activate iframe to prevent immediate re-teleportation
+            particle.portalIframe_ = true;
         }
     }
+
+    if (portalVfxCooldown_ <= 0.0f) {
+
+        // Spawn particles at the INPUT portal pos
+        // vfx.spawnVFX(VFXType::PortalBurst, portal.transform_.pos_,
+        // portal.transform_.rotationRad_);
+
+        // Spawn the particles at the OUTPUT portal pos
+        vfxSystem_->spawnVFX(VFXType::PortalBurst, exitPortal.transform_.pos_,
+                             exitPortal.transform_.rotationRad_);
+
+        // Lock the timer for 0.25 seconds (Only 4 bursts allowed per second)
+        portalVfxCooldown_ = 0.25f;
+    }
 }
 
 // =========================================================
@@ -329,9 +412,9 @@ void PortalSystem::draw() {
         AEGfxSetBlendMode(AE_GFX_BM_BLEND);
         AEGfxSetTransparency(1.0f);
         // Render start points
-        for (auto& portal : portalVec_) {
-            AEGfxSetColorToMultiply(portal->red_, portal->green_, portal->blue_, 1.0f);
-            AEGfxSetTransform(portal->transform_.worldMtx_.m);
+        for (Portal& portal : portals_) {
+            AEGfxSetColorToMultiply(portal.red_, portal.green_, portal.blue_, 1.0f);
+            AEGfxSetTransform(portal.transform_.worldMtx_.m);
             AEGfxMeshDraw(portalGraphicsConfigs_.mesh_, AE_GFX_MDM_TRIANGLES);
         }
     } else {
@@ -339,9 +422,9 @@ void PortalSystem::draw() {
         AEGfxSetRenderMode(AE_GFX_RM_TEXTURE);
         AEGfxSetBlendMode(AE_GFX_BM_BLEND);
         AEGfxSetTransparency(1.0f);
-        for (auto& portal : portalVec_) {
-            AEGfxSetColorToMultiply(portal->red_, portal->green_, portal->blue_, 1.0f);
-            AEGfxSetTransform(portal->transform_.worldMtx_.m);
+        for (Portal& portal : portals_) {
+            AEGfxSetColorToMultiply(portal.red_, portal.green_, portal.blue_, 1.0f);
+            AEGfxSetTransform(portal.transform_.worldMtx_.m);
             AEGfxTextureSet(portalGraphicsConfigs_.texture_, 0.0f, 0.0f);
             AEGfxMeshDraw(portalGraphicsConfigs_.mesh_, AE_GFX_MDM_TRIANGLES);
         }
@@ -372,10 +455,11 @@ void PortalSystem::drawPreview() {
     // RGB set based on next portal colors
     // If current_portal exist, use its colors
     f32 r = nextRed_, g = nextGreen_, b = nextBlue_;
-    if (currentPortal_ != nullptr) {
-        r = currentPortal_->red_;
-        g = currentPortal_->green_;
-        b = currentPortal_->blue_;
+    if (currentPortal_ >= 0) {
+        const Portal& current = portals_[currentPortal_];
+        r = current.red_;
+        g = current.green_;
+        b = current.blue_;
     }
 
     AEGfxSetRenderMode(AE_GFX_RM_TEXTURE);
@@ -416,8 +500,8 @@ void PortalSystem::drawPreview() {
 // PortalSystem::free()
 //
 // - Frees the shared rect mesh and both textures.
-// - Deletes all heap-allocated Portal objects and clears the vector.
-// - Resets currentPortal_ to nullptr.
+// - Clears the portal pool, keeping its capacity for the next level.
+// - Resets currentPortal_ to -1.
 //
 // =========================================================
 void PortalSystem::free() {
@@ -435,13 +519,10 @@ void PortalSystem::free() {
         AEGfxTextureUnload(arrowGraphicsConfigs_.texture_);
         arrowGraphicsConfigs_.texture_ = nullptr;
     }
-    for (auto& portal : portalVec_) {
-        portal->linkedPortal_ = nullptr;
-        delete portal;
-    }
-    portalVec_.clear();
+    portals_.clear();
+    transits_.clear();
 
-    currentPortal_ = nullptr;
+    currentPortal_ = -1;
 }
 
 // =========================================================
@@ -450,7 +531,8 @@ void PortalSystem::free() {
 //
 // - If the click iframe is active, returns immediately.
 // - Checks whether the mouse overlaps any portal's AABB.
-// - If so, unlinks and deletes that portal, then returns.
+// - If so, unlinks and removes that portal, shifting the links of the
+// - portals after it down by one, then returns.
 // - Otherwise, places a new portal at the mouse position via setupPortal().
 // - Sets the iframe after any action to prevent double-triggering.
 //
@@ -465,30 +547,18 @@ void PortalSystem::checkMouseClick() {
     // Use mouse pos to check collision with portal
     // Check by checking if mouse pos falls within the portal's collider box
     // If it collides with a portal, delete portal and return
-    for (auto portal = portalVec_.begin(); portal != portalVec_.end();) {
-        Portal* currentPortal = *portal;
-        f32 rectHalfWidth = currentPortal->collider_.shapeData_.box_.size_.x / 2.0f;
-        f32 rectHalfHeight = currentPortal->collider_.shapeData_.box_.size_.y / 2.0f;
-        if (mousePos_.x >= (currentPortal->transform_.pos_.x - rectHalfWidth) &&
-            mousePos_.x <= (currentPortal->transform_.pos_.x + rectHalfWidth) &&
-            mousePos_.y >= (currentPortal->transform_.pos_.y - rectHalfHeight) &&
-            mousePos_.y <= (currentPortal->transform_.pos_.y + rectHalfHeight)) {
+    for (size_t i = 0; i < portals_.size(); ++i) {
+        const Portal& clickedPortal = portals_[i];
+        if (mousePos_.x >= (clickedPortal.transform_.pos_.x - clickedPortal.halfExtents_.x) &&
+            mousePos_.x <= (clickedPortal.transform_.pos_.x + clickedPortal.halfExtents_.x) &&
+            mousePos_.y >= (clickedPortal.transform_.pos_.y - clickedPortal.halfExtents_.y) &&
+            mousePos_.y <= (clickedPortal.transform_.pos_.y + clickedPortal.halfExtents_.y)) {
             // std::cout << "Mouse is over portal!\n";
             //  Remove portal
-            if (currentPortal->linkedPortal_ != nullptr) {
-                currentPortal->linkedPortal_->linkedPortal_ = nullptr;
-                currentPortal->linkedPortal_ = nullptr;
-            }
-            portal = portalVec_.erase(portal);
-            if (currentPortal == currentPortal_) {
-                currentPortal_ = nullptr;
-            }
-            delete currentPortal;
+            removePortal(static_cast<s32>(i));
             g_audioSystem.playSound("wormhole_place", "sfx", 2.0f, 1.0f);
             clickIframe_ = true;
             return;
-        } else {
-            ++portal;
         }
     }
     // Else setup new portal at mouse position
@@ -499,6 +569,35 @@ void PortalSystem::checkMouseClick() {
     clickIframe_ = true;
 }
 
+// =========================================================
+//
+// PortalSystem::removePortal(s32 index)
+//
+// - Unlinks the portal's partner, then erases it from the pool.
+// - Every link and currentPortal_ pointing past the removed slot is
+// - shifted down by one so the pool keeps its placement order.
+// - The pool keeps its capacity, so removal never frees memory.
+//
+// =========================================================
+void PortalSystem::removePortal(s32 index) {
+    const s32 linkedIndex = portals_[index].linkedIndex_;
+    if (linkedIndex >= 0) {
+        portals_[linkedIndex].linkedIndex_ = -1;
+    }
+    portals_.erase(portals_.begin() + index);
+
+    for (Portal& portal : portals_) {
+        if (portal.linkedIndex_ > index) {
+            --portal.linkedIndex_;
+        }
+    }
+    if (currentPortal_ == index) {
+        currentPortal_ = -1;
+    } else if (currentPortal_ > index) {
+        --currentPortal_;
+    }
+}
+
 // =========================================================
 //
 // PortalSystem::resetIframe()
@@ -535,8 +634,8 @@ void PortalSystem::rotatePortal() {
 
 f32 PortalSystem::getRotationValue() const { return rotationValue_; }
 
-const std::vector<Portal*>& PortalSystem::getPortals() const { return portalVec_; }
+const std::vector<Portal>& PortalSystem::getPortals() const { return portals_; }
 
 int PortalSystem::getPortalLimit() const { return portalLimit_; }
 
-int PortalSystem::getPortalCount() const { return static_cast<int>(portalVec_.size()); }
\ No newline at end of file
+int PortalSystem::getPortalCount() const { return static_cast<int>(portals_.size()); }
\ No newline at end of file
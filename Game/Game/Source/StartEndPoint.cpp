@@ -19,6 +19,7 @@
 // =============================
 // Standard library
 // =============================
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <iostream>
@@ -32,7 +33,6 @@
 // Project
 // =============================
 #include "AudioSystem.h"
-#include "CollisionSystem.h"
 #include "MouseUtils.h"
 
 // =========================================================
@@ -220,6 +220,7 @@ void StartEndPoint::free() {
 // StartEndPoint::setupPoint()
 //
 // - Appends a new pipe start point to startPoints_ if type is Pipe,
+// - starting it on the pipe schedule's start delay,
 // - or replaces the single end point if type is Flower.
 //
 // =========================================================
@@ -227,6 +228,8 @@ void StartEndPoint::setupPoint(AEVec2 pos, AEVec2 scale, f32 rotation, StartEndT
                                GoalDirection direction) {
     if (type == StartEndType::Pipe) {
         startPoints_.emplace_back(pos, scale, rotation, type, direction);
+        startPoints_.back().spawnTimer_ = pipeSchedule_.startDelay_;
+        startPoints_.back().resting_ = pipeSchedule_.startDelay_ > 0.0f;
     } else if (type == StartEndType::Flower) {
         endPoint_ = StartEnd(pos, scale, rotation, type, direction);
     }
@@ -289,97 +292,163 @@ void StartEndPoint::deleteAtMousePos() {
 
 // =========================================================
 //
-// StartEndPoint::collisionCheckWithWater(StartEnd startend, FluidParticle particle)
+// StartEndPoint::setPipeSchedule(const PipeSchedule& schedule)
 //
-// - Simple axis-aligned AABB-circle collision test (no rotation).
-// - Finds the closest point on the box to the circle center and
-// - checks whether the squared distance is less than the radius squared.
+// - Replaces the emission schedule shared by all pipes.
+// - Restarts every pipe on it: the first particle waits out the
+// - schedule's start delay, and any burst in progress is dropped.
 //
 // =========================================================
-bool StartEndPoint::collisionCheckWithWater(StartEnd startend, FluidParticle particle) {
-    // Circle to Rectangle Collision Detection
-    // Find the closest point to the circle within the rectangle
-    f32 rectHalfWidth = startend.collider_.shapeData_.box_.size_.x / 2.0f;
-    f32 rectHalfHeight = startend.collider_.shapeData_.box_.size_.y / 2.0f;
-    f32 closest_x =
-        fmaxf(startend.transform_.pos_.x - rectHalfWidth,
-              fminf(particle.transform_.pos_.x, startend.transform_.pos_.x + rectHalfWidth));
-    f32 closest_y =
-        fmaxf(startend.transform_.pos_.y - rectHalfHeight,
-              fminf(particle.transform_.pos_.y, startend.transform_.pos_.y + rectHalfHeight));
-    // Calculate the distance between the circle's center and this closest point
-    f32 distance_x = particle.transform_.pos_.x - closest_x;
-    f32 distance_y = particle.transform_.pos_.y - closest_y;
-    // If the distance is less than the circle's radius, an intersection occurs
-    f32 distance_squared = (distance_x * distance_x) + (distance_y * distance_y);
-    f32 radius = particle.collider_.shapeData_.circle_.radius_;
+void StartEndPoint::setPipeSchedule(const PipeSchedule& schedule) {
+    pipeSchedule_ = schedule;
+    for (auto& startPoint : startPoints_) {
+        startPoint.spawnTimer_ = pipeSchedule_.startDelay_;
+        startPoint.burstSpawned_ = 0;
+        startPoint.resting_ = pipeSchedule_.startDelay_ > 0.0f;
+        startPoint.vfxTimer_ = 0.0f;
+    }
+}
+
+// =========================================================
+//
+// StartEndPoint::update(f32 dt, FluidSystem& fluidSystem, VFXSystem& vfxSystem)
+//
+// - Runs the emission schedule of every active pipe (see updatePipe).
+// - Registers the end point's box with the trigger pass (see onTriggerHits).
+// - Pipes are not registered: water touching a pipe has no effect.
+//
+// =========================================================
+void StartEndPoint::update(f32 dt, FluidSystem& fluidSystem, VFXSystem& vfxSystem) {
+    vfxSystem_ = &vfxSystem;
 
-    return distance_squared < (radius * radius);
+    for (size_t i = 0; i < startPoints_.size(); ++i) {
+        StartEnd& startPoint = startPoints_[i];
+        if (startPoint.active_ && startPoint.type_ == StartEndType::Pipe)
+            updatePipe(startPoint, static_cast<s32>(i), dt, fluidSystem, vfxSystem);
+    }
+
+    // Register the end point with the trigger pass
+    TriggerRegistry& triggerRegistry = fluidSystem.getTriggerRegistry();
+    triggerRegistry.addOrientedBox(TriggerSystem::EndPoint, endPoint_.transform_.pos_,
+                                   getHalfExtents(endPoint_), 0.0f, this, 0);
 }
 
 // =========================================================
 //
-// StartEndPoint::update(f32 dt, std::vector<FluidParticle>& particlePool, VFXSystem& vfxSystem)
+// StartEndPoint::updatePipe(StartEnd& pipe, s32 pipeIndex, f32 dt, ...)
 //
-// - For each active start point: checks particle collisions (no action yet)
-// - and fires pipe-flow VFX at ~8 bursts per second while water is flowing.
-// - For the end point: absorbs any colliding particle  increments
-// - particlesCollected_, erases the particle from the pool, and plays a sound.
+// - Counts down the pipe's spawn timer, and while the pipe is releasing
+// - water with some left, emits one particle each time it runs out.
+// - In burst schedules, rests for burstPause_ after every burstCount_
+// - particles.
+// - Fires pipe-flow VFX every vfxInterval_ while the pipe is emitting,
+// - and not while it is off, empty or resting.
+// - The timers keep running while the pipe is off, but never bank
+// - particles: turning it back on emits at most one right away.
 //
 // =========================================================
-void StartEndPoint::update(f32 dt, std::vector<FluidParticle>& particlePool, VFXSystem& vfxSystem) {
-    (void)dt; // unused for now
+void StartEndPoint::updatePipe(StartEnd& pipe, s32 pipeIndex, f32 dt, FluidSystem& fluidSystem,
+                               VFXSystem& vfxSystem) {
+    pipe.spawnTimer_ -= dt;
 
-    // Check collision for each start/end point with each water particle
-    for (auto& startPoint : startPoints_) {
-        if (startPoint.active_ == false) {
-            continue;
-        }
-        for (auto& particle : particlePool) {
-            if (collisionCheckWithWater(startPoint, particle)) {
-                CollisionSystem::incrementCollisionCount();
-                // Handle collision with start point
-                // For example, you can reset the particle's position or apply some effect
-                // std::cout << "Particle collided with start point!\n";
-            }
+    const bool flowing = pipe.releaseWater_ && (pipe.waterRemaining_ > 0.0f || pipe.infiniteWater_);
+    if (!flowing) {
+        pipe.spawnTimer_ = (std::max)(pipe.spawnTimer_, 0.0f);
+        pipe.vfxTimer_ = 0.0f; // Fires immediately when the pipe is turned back on
+        return;
+    }
+
+    if (pipe.spawnTimer_ <= 0.0f) {
+        // Reset rather than accumulate, so a long frame emits one particle, not a clump
+        pipe.spawnTimer_ = pipeSchedule_.spawnInterval_;
+        pipe.resting_ = false;
+        emitParticle(pipe, pipeIndex, fluidSystem);
+
+        if (pipeSchedule_.burstCount_ > 0 && ++pipe.burstSpawned_ >= pipeSchedule_.burstCount_) {
+            pipe.burstSpawned_ = 0;
+            pipe.spawnTimer_ = pipeSchedule_.burstPause_;
+            pipe.resting_ = pipeSchedule_.burstPause_ > 0.0f;
         }
+    }
 
-        // VFX: emit a water-mist burst while the pipe is flowing
-        if (startPoint.releaseWater_ &&
-            (startPoint.waterRemaining_ > 0.0f || startPoint.infiniteWater_)) {
-            startPoint.vfxTimer_ -= dt;
-            if (startPoint.vfxTimer_ <= 0.0f) {
-                // Spawn at the pipe mouth (bottom-centre of the pipe rect)
-                AEVec2 spawnPos = {startPoint.transform_.pos_.x,
-                                   startPoint.transform_.pos_.y -
-                                       startPoint.transform_.scale_.y * 0.5f};
-                vfxSystem.spawnVFX(VFXType::PipeFlow, spawnPos);
-                startPoint.vfxTimer_ = 0.12f; // ~8-9 bursts per second
-            }
-        } else {
-            startPoint.vfxTimer_ = 0.0f; // reset when pipe is off so it fires immediately on toggle
+    if (pipe.resting_) {
+        pipe.vfxTimer_ = 0.0f;
+        return;
+    }
+
+    // VFX: a water-mist burst at the pipe mouth (bottom-centre of the pipe rect)
+    pipe.vfxTimer_ -= dt;
+    if (pipe.vfxTimer_ <= 0.0f) {
+        AEVec2 spawnPos = {pipe.transform_.pos_.x,
+                           pipe.transform_.pos_.y - pipe.transform_.scale_.y * 0.5f};
+        vfxSystem.spawnVFX(VFXType::PipeFlow, spawnPos);
+        pipe.vfxTimer_ = pipeSchedule_.vfxInterval_;
+    }
+}
+
+// =========================================================
+//
+// StartEndPoint::emitParticle(StartEnd& pipe, s32 pipeIndex, FluidSystem& fluidSystem)
+//
+// - Spends waterPerParticle_ of the pipe's water unless it is infinite,
+// - stopping the pipe once the water runs out.
+// - Spawns the particle at a random point along the pipe mouth, tagged
+// - with its pipe so culled water is refunded (see refundCulledWater).
+//
+// =========================================================
+void StartEndPoint::emitParticle(StartEnd& pipe, s32 pipeIndex, FluidSystem& fluidSystem) {
+    if (!pipe.infiniteWater_) {
+        pipe.waterRemaining_ -= waterPerParticle_;
+        if (pipe.waterRemaining_ < 0.0f) {
+            pipe.waterRemaining_ = 0.0f;
+            pipe.releaseWater_ = false; // Auto-stop when empty
         }
     }
 
-    // Check collision for end point with each water particle
-    for (auto particleIt = particlePool.begin(); particleIt != particlePool.end();) {
-        if (collisionCheckWithWater(endPoint_, *particleIt)) {
-            CollisionSystem::incrementCollisionCount();
-            // Handle collision with end point
-            // std::cout << "Particle collided with end point! Removing particle.\n";
-            particlesCollected_++;
+    // The last of the water is spent without a particle
+    if (pipe.waterRemaining_ <= 0.0f && !pipe.infiniteWater_)
+        return;
 
-            vfxSystem.spawnVFX(VFXType::FlowerCollect, endPoint_.transform_.pos_);
+    const f32 radius = pipeSchedule_.particleRadius_;
+    const f32 halfWidth = pipe.transform_.scale_.x / 2.0f;
+    const f32 posX = pipe.transform_.pos_.x + AERandFloat() * pipe.transform_.scale_.x - halfWidth;
+    const f32 posY = pipe.transform_.pos_.y - pipe.transform_.scale_.y / 2.0f - radius;
+    fluidSystem.spawnParticle(posX, posY, radius, FluidType::Water, pipeIndex);
+}
 
-            // Remove this particle from the pool
-            particleIt = particlePool.erase(particleIt); // Erase returns the next valid iterator
+// =========================================================
+//
+// StartEndPoint::onTriggerHits(u32 tag, ...)
+//
+// - Called by the trigger pass with the water particles inside the end
+// - point that no earlier trigger has consumed.
+// - Absorbs every one: increments particlesCollected_ and consumes it,
+// - so the pass removes the whole batch in one compaction.
+// - Plays one drip sound and spawns one FlowerCollect burst for the batch,
+// - both scaled by the number collected, instead of one per particle.
+//
+// =========================================================
+void StartEndPoint::onTriggerHits(u32 tag, const std::vector<u32>& particleIndices,
+                                  TriggerRegistry& registry, FluidSystem& fluidSystem) {
+    (void)tag;
+    (void)fluidSystem;
 
-            // Play pop sound
-            g_audioSystem.playSound("drip_water", "sfx", 0.4f, 1.0f);
-        } else {
-            ++particleIt; // Increment iterator only if no deletion occurred
-        }
+    for (u32 index : particleIndices) {
+        // Removed from the pool once the pass is over
+        registry.consumeParticle(index);
     }
+
+    const u32 collected = static_cast<u32>(particleIndices.size());
+    particlesCollected_ += static_cast<s32>(collected);
+
+    // One VFX burst and one pop sound for the batch, scaled by its size
+    const f32 extraParticles = static_cast<f32>(collected - 1);
+    vfxSystem_->spawnVFX(VFXType::FlowerCollect, endPoint_.transform_.pos_, 0.0f,
+                         (std::min)(static_cast<f32>(collected), collectVfxScaleMax_));
+    g_audioSystem.playSound(
+        "drip_water", "sfx",
+        (std::min)(collectVolume_ + extraParticles * collectVolumePerParticle_, collectVolumeMax_),
+        1.0f);
 }
 
 // =========================================================
@@ -699,3 +768,25 @@ void StartEndPoint::toggleInfiniteWater() {
         }
     }
 }
+
+// =========================================================
+//
+// StartEndPoint::refundCulledWater(FluidSystem& fluidSystem)
+//
+// - Returns water to each pipe for every particle it emitted that the
+// - fluid system culled out of bounds, clamped to the pipe's capacity.
+//
+// =========================================================
+void StartEndPoint::refundCulledWater(FluidSystem& fluidSystem) {
+    for (size_t i = 0; i < startPoints_.size(); ++i) {
+        const u32 culled = fluidSystem.takeCulledFromSource(static_cast<s32>(i));
+        StartEnd& startPoint = startPoints_[i];
+        if (culled == 0 || startPoint.type_ != StartEndType::Pipe || startPoint.infiniteWater_)
+            continue;
+
+        startPoint.waterRemaining_ += static_cast<f32>(culled) * waterPerParticle_;
+        if (startPoint.waterRemaining_ > startPoint.waterCapacity_) {
+            startPoint.waterRemaining_ = startPoint.waterCapacity_;
+        }
+    }
+}
@@ -26,6 +26,8 @@
 #include "States/Level.h"
 
 // Standard library
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -61,9 +63,7 @@
 // ==========================================
 // Terrain Static Variables
 // ==========================================
-static Terrain* dirt = nullptr;
-static Terrain* stone = nullptr;
-static Terrain* magic = nullptr;
+static Terrain* terrain = nullptr; // Dirt, stone and magic share one grid
 static AEGfxTexture* pTerrainDirtTex{nullptr};
 static AEGfxTexture* pTerrainStoneTex{nullptr};
 static AEGfxTexture* pTerrainMagicTex{nullptr};
@@ -122,6 +122,17 @@ static f32 kGoalFlowerFrameTime = 0.25f;
 static int winThresholdDivisor = 4;
 static bool winTriggered = false;
 
+// MossStressTest debug harness. Turning the toggle on restarts the level into a fixed stress
+// layout, which counts the moss checks and hits over a set number of frames and logs the totals.
+// Turning it off restarts the level as authored.
+static bool mossStressLayout = false; // Current load is the stress layout, kept across restarts
+static int mossStressFrames = 0;      // Frames the totals cover
+static int mossStressFramesLeft = 0;  // Frames still to count, 0 once the totals are logged
+static int mossStressMoss = 0;        // Moss placed by the layout
+static int mossStressParticles = 0;   // Water particles the layout floods it with
+static u64 mossStressChecks = 0;
+static u64 mossStressHits = 0;
+
 // ==========================================
 // Fonts
 // ==========================================
@@ -145,7 +156,9 @@ static UIFader someOtherCoolAnimation;
 // ==========================================
 // Static Functions Declarations
 // ==========================================
-static void spawnWaterWithLimit(f32 deltaTime);
+static void buildMossStressTank();
+static void runMossStressTest();
+static void recordMossStressFrame();
 static void drawHudIcon(AEGfxTexture* tex, AEGfxVertexList* mesh, f32 worldX, f32 worldY,
                         f32 iconSize, f32 uvOffsetX = 0.0f);
 static void drawPixelBar(f32 worldX, f32 worldY, f32 barWidth, f32 barHeight, f32 fillR, f32 fillG,
@@ -159,15 +172,12 @@ static void drawGoalBar(f32 x, f32 y, f32 percentage);
 // loadLevel()
 //
 // - Loads all persistent assets needed for the level:
-// - terrain meshes/textures, fonts, systems, HUD text, and UI buttons.
+// - terrain colliders/textures, fonts, systems, HUD text, and UI buttons.
 // - Called once per level session (not on restart).
 //
 // =========================================================
 void loadLevel() {
     // Terrain & Background
-    Terrain::createMeshLibrary();
-    Terrain::createColliderLibrary();
-
     pTerrainDirtTex = AEGfxTextureLoad("Assets/Textures/terrain_dirt.png");
     pTerrainStoneTex = AEGfxTextureLoad("Assets/Textures/terrain_stone.png");
     pTerrainMagicTex = AEGfxTextureLoad("Assets/Textures/terrain_magic.png");
@@ -234,6 +244,8 @@ void loadLevel() {
         portalLimit = g_configManager.getInt("Level", "defaults", "portalLimit", 0);
         fileExist = false;
     }
+    // A newly loaded level starts as authored, the MossStressTest toggle restarts it if needed
+    mossStressLayout = false;
 
     // UI buttons
     buttonPause.loadMesh();
@@ -263,58 +275,51 @@ void loadLevel() {
 //
 // =========================================================
 void initializeLevel() {
+    // The stress layout replaces everything the level file would add
+    const bool loadContent = fileExist && !mossStressLayout;
+
     // Systems
     fluidSystem.initialize();
+    if (loadContent) {
+        fluidSystem.setRefundCulledWater(
+            levelManager.parseRefundToPipe(fluidSystem.getRefundCulledWater()));
+    }
     portalSystem.initialize(portalLimit);
     mossSystem.initialize();
 
     // Terrain
-    dirt = new Terrain(TerrainMaterial::Dirt, pTerrainDirtTex, {0.0f, 0.0f}, height, width,
-                       tileSize, true);
-    stone = new Terrain(TerrainMaterial::Stone, pTerrainStoneTex, {0.0f, 0.0f}, height, width,
-                        tileSize, true);
-    magic = new Terrain(TerrainMaterial::Magic, pTerrainMagicTex, {0.0f, 0.0f}, height, width,
-                        tileSize, false);
-    if (fileExist) {
-        levelManager.parseTerrainInfo(dirt->getNodes(), "Dirt");
-    }
-    dirt->initCellsTransform();
-    dirt->initCellsGraphics();
-    dirt->initCellsCollider();
-    dirt->updateTerrain();
-
-    if (fileExist) {
-        levelManager.parseTerrainInfo(stone->getNodes(), "Stone");
-    }
-    stone->initCellsTransform();
-    stone->initCellsGraphics();
-    stone->initCellsCollider();
-    stone->updateTerrain();
-
-    if (fileExist) {
-        levelManager.parseTerrainInfo(magic->getNodes(), "Magic");
+    terrain = new Terrain({0.0f, 0.0f}, height, width, tileSize);
+    terrain->setTexture(TerrainMaterial::Dirt, pTerrainDirtTex);
+    terrain->setTexture(TerrainMaterial::Stone, pTerrainStoneTex);
+    terrain->setTexture(TerrainMaterial::Magic, pTerrainMagicTex);
+    // Enabled before loading so a saved density layer is restored with the nodes
+    terrain->setDensityEnabled(g_configManager.getBool("Level", "terrain", "densityNodes", false));
+    if (loadContent) {
+        levelManager.parseTerrainInfo(*terrain);
+    } else if (mossStressLayout) {
+        buildMossStressTank();
     }
-    magic->initCellsTransform();
-    magic->initCellsGraphics();
-    magic->initCellsCollider();
-    magic->updateTerrain();
+    terrain->initCells();
 
     // Game Objects
     startEndPointSystem.initialize();
-    if (fileExist) {
+    if (loadContent) {
         levelManager.parseStartEndInfo(startEndPointSystem);
     }
 
     collectibleSystem.initialize();
-    if (fileExist) {
+    if (loadContent) {
         levelManager.parseCollectibleInfo(collectibleSystem);
     }
-    if (fileExist) {
+    if (loadContent) {
         levelManager.parseMossInfo(mossSystem);
     }
-    if (fileExist) {
+    if (loadContent) {
         levelManager.parsePortalInfo(portalSystem);
     }
+    if (mossStressLayout) {
+        runMossStressTest();
+    }
 
     // VFX Systems
     vfxSystem.initialize(g_configManager.getInt("Level", "vfx", "poolSize", 800),
@@ -381,7 +386,7 @@ void initializeLevel() {
     animManager.add(&someOtherCoolAnimation);
     animManager.initializeAll();
 
-    g_debugSystem.setScene(dirt, stone, magic, &fluidSystem, &collectibleSystem, &portalSystem,
+    g_debugSystem.setScene(terrain, &fluidSystem, &collectibleSystem, &portalSystem,
                            &startEndPointSystem, &vfxSystem);
 }
 
@@ -462,10 +467,9 @@ void updateLevel(GameStateManager& GSM, f32 deltaTime) {
 
                 // System updates for editor mode
                 levelManager.updateLevelEditor();
-                collectibleSystem.update(deltaTime, fluidSystem.getParticlePool(FluidType::Water),
-                                         vfxSystem);
-                mossSystem.update(deltaTime, fluidSystem.getParticlePool(FluidType::Water),
-                                  startEndPointSystem, vfxSystem);
+                collectibleSystem.update(deltaTime, fluidSystem, vfxSystem);
+                mossSystem.update(deltaTime, fluidSystem, startEndPointSystem, vfxSystem);
+                fluidSystem.dispatchTriggers();
                 portalSystem.rotatePortal();
 
                 // Inputs to build level
@@ -474,23 +478,23 @@ void updateLevel(GameStateManager& GSM, f32 deltaTime) {
                     switch (levelManager.getCurrentGameBlock()) {
                     case GameBlock::Dirt:
                         if (AEInputCheckCurr(AEVK_LBUTTON)) {
-                            dirt->buildAtMouse(brush_size);
+                            terrain->buildAtMouse(TerrainMaterial::Dirt, brush_size);
                         } else if (AEInputCheckCurr(AEVK_RBUTTON)) {
-                            dirt->destroyAtMouse(brush_size);
+                            terrain->destroyAtMouse(TerrainMaterial::Dirt, brush_size);
                         }
                         break;
                     case GameBlock::Stone:
                         if (AEInputCheckCurr(AEVK_LBUTTON)) {
-                            stone->buildAtMouse(brush_size);
+                            terrain->buildAtMouse(TerrainMaterial::Stone, brush_size);
                         } else if (AEInputCheckCurr(AEVK_RBUTTON)) {
-                            stone->destroyAtMouse(brush_size);
+                            terrain->destroyAtMouse(TerrainMaterial::Stone, brush_size);
                         }
                         break;
                     case GameBlock::Magic:
                         if (AEInputCheckCurr(AEVK_LBUTTON)) {
-                            magic->buildAtMouse(brush_size);
+                            terrain->buildAtMouse(TerrainMaterial::Magic, brush_size);
                         } else if (AEInputCheckCurr(AEVK_RBUTTON)) {
-                            magic->destroyAtMouse(brush_size);
+                            terrain->destroyAtMouse(TerrainMaterial::Magic, brush_size);
                         }
                         break;
                     case GameBlock::StartPoint:
@@ -524,7 +528,7 @@ void updateLevel(GameStateManager& GSM, f32 deltaTime) {
                         }
                         break;
                     case GameBlock::Portal:
-                        if (magic->isNearestNodeToMouseAtThreshold() == true) {
+                        if (terrain->isNearestNodeToMouseMaterial(TerrainMaterial::Magic) == true) {
                             if (AEInputCheckTriggered(AEVK_RBUTTON)) {
                                 portalSystem.checkMouseClick();
                             } else if (AEInputCheckReleased(AEVK_RBUTTON)) {
@@ -536,13 +540,16 @@ void updateLevel(GameStateManager& GSM, f32 deltaTime) {
                         break;
                     }
                 }
-                // Inputs to save level (Current save input: Press S)
-                if (AEInputCheckReleased(AEVK_S)) {
+                // No fluid step runs in the editor, so commit the brush edits here
+                terrain->commitEdits();
+
+                // Inputs to save level (Current save input: Press S). The stress layout is
+                // never written over the level file.
+                if (AEInputCheckReleased(AEVK_S) && !mossStressLayout) {
                     levelManager.saveMapInfo(width, height, tileSize,
-                                             portalSystem.getPortalLimit());
-                    levelManager.saveTerrainInfo(dirt->getNodes(), "Dirt");
-                    levelManager.saveTerrainInfo(stone->getNodes(), "Stone");
-                    levelManager.saveTerrainInfo(magic->getNodes(), "Magic");
+                                             portalSystem.getPortalLimit(),
+                                             fluidSystem.getRefundCulledWater());
+                    levelManager.saveTerrainInfo(*terrain);
                     levelManager.saveStartEndInfo(startEndPointSystem.startPoints_,
                                                   startEndPointSystem.endPoint_);
                     levelManager.saveCollectibleInfo(collectibleSystem.getCollectibles());
@@ -560,7 +567,7 @@ void updateLevel(GameStateManager& GSM, f32 deltaTime) {
 
                 // Input for gameplay (Current save input: Left-Click)
                 if (AEInputCheckCurr(AEVK_LBUTTON)) {
-                    bool hitDirt = dirt->destroyAtMouse(20.0f);
+                    bool hitDirt = terrain->destroyAtMouse(TerrainMaterial::Dirt, 20.0f);
                     // Only run the VFX timer if we actually dug through dirt
                     if (hitDirt) {
                         vfxSystem.spawnContinuous(VFXType::DirtBurst, getMouseWorldPos(), deltaTime,
@@ -583,7 +590,7 @@ void updateLevel(GameStateManager& GSM, f32 deltaTime) {
                 }
 
                 // If magic terrain is near mouse click, place portal
-                if (magic->isNearestNodeToMouseAtThreshold() == true) {
+                if (terrain->isNearestNodeToMouseMaterial(TerrainMaterial::Magic) == true) {
                     if (AEInputCheckTriggered(AEVK_RBUTTON) || 0 == AESysDoesWindowExist()) {
                         portalSystem.checkMouseClick();
                     } else if (AEInputCheckReleased(AEVK_RBUTTON)) {
@@ -624,18 +631,26 @@ void updateLevel(GameStateManager& GSM, f32 deltaTime) {
                 portalLimitText.content_ =
                     "Portals: " + std::to_string(portalsUsed) + "/" + std::to_string(portalsLimit);
 
+                // Debug: the MossStressTest toggle restarts the level into the stress layout,
+                // and back into the authored level when it is cleared
+                const bool mossStressTestOn = g_debugSystem.options_.count("MossStressTest") &&
+                                              g_debugSystem.options_.at("MossStressTest");
+                if (mossStressTestOn != mossStressLayout) {
+                    mossStressLayout = mossStressTestOn;
+                    screenFader.startFadeOut(&GSM, StateId::Restart);
+                }
+
                 // System updates for gameplay
-                spawnWaterWithLimit(deltaTime);
-                collectibleSystem.update(deltaTime, fluidSystem.getParticlePool(FluidType::Water),
-                                         vfxSystem);
-                mossSystem.update(deltaTime, fluidSystem.getParticlePool(FluidType::Water),
-                                  startEndPointSystem, vfxSystem);
-                fluidSystem.update(deltaTime, {dirt, stone});
-                startEndPointSystem.update(deltaTime, fluidSystem.getParticlePool(FluidType::Water),
-                                           vfxSystem);
-                portalSystem.update(deltaTime, fluidSystem.getParticlePool(FluidType::Water),
-                                    vfxSystem);
+                collectibleSystem.update(deltaTime, fluidSystem, vfxSystem);
+                mossSystem.update(deltaTime, fluidSystem, startEndPointSystem, vfxSystem);
+                fluidSystem.update(deltaTime, {terrain});
+                startEndPointSystem.refundCulledWater(fluidSystem);
+                startEndPointSystem.update(deltaTime, fluidSystem, vfxSystem);
+                portalSystem.update(deltaTime, fluidSystem, vfxSystem);
+                fluidSystem.dispatchTriggers();
                 vfxSystem.update(deltaTime);
+                if (mossStressLayout)
+                    recordMossStressFrame();
 
                 // Animate goal bar icon
                 goalFlowerFrameTimer_ += deltaTime;
@@ -649,7 +664,8 @@ void updateLevel(GameStateManager& GSM, f32 deltaTime) {
                 // CheckWinCondition uses particleMaxCount_/3 which is a higher
                 // bar than the display, causing the win to fire after the bar
                 // already shows 100%. Using goalPercentage >= 100 keeps both in sync.
-                if (goalPercentage >= 100.0f && !winTriggered) {
+                // The stress layout never wins, so it cannot write level progress.
+                if (goalPercentage >= 100.0f && !winTriggered && !mossStressLayout) {
                     winTriggered = true;
 
                     // Save highscore
@@ -707,9 +723,7 @@ void drawLevel() {
     fluidSystem.drawColor();
     startEndPointSystem.drawTexture(fluidSystem.particleMaxCount_);
 
-    dirt->renderTerrain();
-    stone->renderTerrain();
-    magic->renderTerrain();
+    terrain->renderTerrain();
     portalSystem.draw();
     vfxSystem.draw();
 
@@ -719,7 +733,7 @@ void drawLevel() {
     // Add preview render in gameplay
     if (levelManager.getLevelEditorMode() == EditorMode::None) {
         // Only show portal preview if mouse is near magic terrain, otherwise default dirt
-        if (magic->isNearestNodeToMouseAtThreshold() == true) {
+        if (terrain->isNearestNodeToMouseMaterial(TerrainMaterial::Magic) == true) {
             portalSystem.drawPreview();
         } else {
             levelManager.drawBrushPreview(TerrainMaterial::Dirt, 20.f);
@@ -849,12 +863,8 @@ void freeLevel() {
     }
 
     // Terrain
-    delete dirt;
-    dirt = nullptr;
-    delete stone;
-    stone = nullptr;
-    delete magic;
-    magic = nullptr;
+    delete terrain;
+    terrain = nullptr;
 }
 
 // =========================================================
@@ -870,7 +880,6 @@ void freeLevel() {
 void unloadLevel() {
     // Systems
     mossSystem.unload();
-    Terrain::freeMeshLibrary();
 
     // Unload fonts
     if (titleFont) {
@@ -941,63 +950,98 @@ void unloadLevel() {
 
 // =========================================================
 //
-// spawnWaterWithLimit(f32 deltaTime)
+// buildMossStressTank()
 //
-// - Spawns water particles from all active pipe-type start points
-// - at a fixed rate, consuming water capacity per spawn.
-// - Automatically stops a pipe when its water is depleted.
+// - Fixed terrain of the moss stress layout: a stone floor and two
+// - stone walls along the level bounds, empty everywhere else, so
+// - the flood pools over the moss and every run starts the same.
+// - Called before initCells.
 //
 // =========================================================
-static void spawnWaterWithLimit(f32 deltaTime) {
-    // Use a static timer that persists between function calls
-    static f32 globalSpawnTimer = 0.0f;
-
-    // Decrement the global timer
-    globalSpawnTimer -= deltaTime;
-
-    // Only spawn if enough time has passed
-    if (globalSpawnTimer <= 0.0f) {
-        // Reset timer to control spawn rate across all start points
-        globalSpawnTimer = 0.025f; // Same spawn rate as before
-
-        // Loop through all start points
-        for (auto& startPoint : startEndPointSystem.startPoints_) {
-            // Only process active pipe-type start points that are releasing water
-            if (startPoint.releaseWater_ && startPoint.type_ == StartEndType::Pipe) {
-
-                // Check if there's water remaining (or infinite mode)
-                if (startPoint.waterRemaining_ > 0.0f || startPoint.infiniteWater_) {
-
-                    // Consume water (unless infinite)
-                    if (!startPoint.infiniteWater_) {
-                        startPoint.waterRemaining_ -= 0.5f; // Adjust consumption rate as needed
-                        if (startPoint.waterRemaining_ < 0.0f) {
-                            startPoint.waterRemaining_ = 0.0f;
-                            startPoint.releaseWater_ = false; // Auto-stop when empty
-                        }
-                    }
+static void buildMossStressTank() {
+    const AEVec2 bottomLeft = terrain->getBottomLeftPos();
+    const f32 levelWidth = static_cast<f32>(width * tileSize);
+    const f32 levelHeight = static_cast<f32>(height * tileSize);
+    const f32 wallRadius = static_cast<f32>(tileSize) * 1.5f;
+
+    const AEVec2 bottomRight{bottomLeft.x + levelWidth, bottomLeft.y};
+    const AEVec2 topLeft{bottomLeft.x, bottomLeft.y + levelHeight};
+    const AEVec2 topRight{bottomRight.x, topLeft.y};
+    terrain->buildStroke(TerrainMaterial::Stone, bottomLeft, bottomRight, wallRadius);
+    terrain->buildStroke(TerrainMaterial::Stone, bottomLeft, topLeft, wallRadius);
+    terrain->buildStroke(TerrainMaterial::Stone, bottomRight, topRight, wallRadius);
+}
 
-                    // Only spawn particle if there's still water
-                    if (startPoint.waterRemaining_ > 0.0f || startPoint.infiniteWater_) {
-                        // Spawn particle at the start point position
-                        f32 randRadius = 10.0f;
-
-                        // Calculate random x offset within the start point's width
-                        f32 xOffset = startPoint.transform_.pos_.x +
-                                      AERandFloat() * startPoint.transform_.scale_.x -
-                                      (startPoint.transform_.scale_.x / 2.f);
-                        AEVec2 position = {xOffset, startPoint.transform_.pos_.y -
-                                                        (startPoint.transform_.scale_.y / 2.f) -
-                                                        (randRadius)};
-
-                        // Spawn the water particle
-                        fluidSystem.spawnParticle(position.x, position.y, randRadius,
-                                                  FluidType::Water);
-                    }
-                }
-            }
-        }
+// =========================================================
+//
+// runMossStressTest()
+//
+// - Debug scenario for the moss trigger cost (MossStressTest toggle),
+// - run by initializeLevel on the stress layout.
+// - Lays a grid of moss inside the tank, then floods it with a
+// - lattice of water particles from the top down. Slots and
+// - particles on solid terrain are skipped.
+// - Seeds rand() so the water's random spread repeats between runs,
+// - and starts counting the moss checks and hits for the totals.
+//
+// =========================================================
+static void runMossStressTest() {
+    std::srand(static_cast<unsigned>(g_configManager.getInt("moss", "stressTest", "seed", 1)));
+
+    // Inside the tank walls
+    const f32 inset = static_cast<f32>(tileSize) * 2.0f;
+    const AEVec2 bottomLeft = terrain->getBottomLeftPos();
+    const AEVec2 innerBottomLeft{bottomLeft.x + inset, bottomLeft.y + inset};
+    const f32 innerWidth = static_cast<f32>(width * tileSize) - inset * 2.0f;
+    const f32 innerHeight = static_cast<f32>(height * tileSize) - inset;
+    mossStressMoss = mossSystem.spawnStressGrid(innerBottomLeft, innerWidth, innerHeight, *terrain);
+
+    const int floodParticles = g_configManager.getInt("moss", "stressTest", "floodParticles", 2000);
+    const f32 radius = g_configManager.getFloat("moss", "stressTest", "floodRadius", 10.0f);
+    const f32 spacing = radius * 2.0f;
+    const int columns = (std::max)(static_cast<int>(innerWidth / spacing), 1);
+    mossStressParticles = 0;
+    for (int i = 0; i < floodParticles; ++i) {
+        const AEVec2 pos{innerBottomLeft.x + radius + static_cast<f32>(i % columns) * spacing,
+                         innerBottomLeft.y + innerHeight - radius -
+                             static_cast<f32>(i / columns) * spacing};
+        if (terrain->isSolidAt(pos))
+            continue;
+
+        fluidSystem.spawnParticle(pos.x, pos.y, radius, FluidType::Water);
+        ++mossStressParticles;
     }
+
+    mossStressFrames = (std::max)(g_configManager.getInt("moss", "stressTest", "frames", 600), 1);
+    mossStressFramesLeft = mossStressFrames;
+    mossStressChecks = 0;
+    mossStressHits = 0;
+}
+
+// =========================================================
+//
+// recordMossStressFrame()
+//
+// - Adds this frame's moss checks and hits to the stress totals.
+// - Once the set number of frames is counted, logs the totals
+// - to the console. The toggle's HUD lines show the per-frame
+// - values meanwhile.
+//
+// =========================================================
+static void recordMossStressFrame() {
+    if (mossStressFramesLeft <= 0)
+        return;
+
+    const CollisionStats& stats = fluidSystem.getCollisionContext().frameStats_;
+    mossStressChecks += stats.triggerChecks_[static_cast<int>(TriggerSystem::Moss)];
+    mossStressHits += stats.triggerHits_[static_cast<int>(TriggerSystem::Moss)];
+    if (--mossStressFramesLeft > 0)
+        return;
+
+    std::cout << "Moss stress test: " << mossStressMoss << " moss, " << mossStressParticles
+              << " particles, " << mossStressFrames << " frames, " << mossStressChecks
+              << " moss checks (" << mossStressChecks / mossStressFrames << " per frame), "
+              << mossStressHits << " moss hits\n";
 }
 
 // =========================================================
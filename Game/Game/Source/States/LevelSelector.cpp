@@ -613,8 +613,7 @@ void updateLevelSelector(GameStateManager& GSM, f32 deltaTime) {
         g_debugSystem.update();
     }
     // Always update
-    std::vector<FluidParticle> dummyPool;
-    lsCollectibleSystem.update(deltaTime, dummyPool, lsVfxSystem);
+    lsCollectibleSystem.animate(deltaTime);
 
     animManager.updateAll(deltaTime);
     confirmationSystem.update();
@@ -597,8 +597,7 @@ void updatePlayerLevel(GameStateManager& GSM, f32 deltaTime) {
         g_debugSystem.update();
     }
     // Always update
-    std::vector<FluidParticle> dummyPool;
-    lsCollectibleSystem.update(deltaTime, dummyPool, lsVfxSystem);
+    lsCollectibleSystem.animate(deltaTime);
 
     animManager.updateAll(deltaTime);
     confirmationSystem.update();
@@ -7,7 +7,7 @@
 
 @brief      This source file contains the definition of functions that make
             the Terrain class, including marching-squares mesh and collider generation, node-based
-            terrain editing, and per-cell transform and render updates.
+            terrain editing, chunk allocation, and per-chunk case classification and rendering.
 
 @copyright  Copyright (C) 2026 DigiPen Institute of Technology.
             Reproduction or disclosure of this file or its contents
@@ -18,6 +18,9 @@
 #include "Terrain.h"
 
 // Standard library
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -26,153 +29,281 @@
 
 // Project
 #include "CollisionSystem.h"
+#include "MarchingSquares.h"
 
-AEGfxVertexList* Terrain::meshLibrary_[16]{nullptr}; // There are 16 possible meshes
-Collider2D Terrain::colliderLibrary_[16][3]{}; // There are 16 possible colliders, [3] as each cell
-                                               // uses 1, 2, or 3 colliders
 AEGfxVertexList* Terrain::debugTriMesh_{nullptr};
 AEGfxVertexList* Terrain::debugBoxMesh_{nullptr};
+u32 Terrain::nextGeneration_{0};
+
+namespace {
+// Node value of each material, indexed by TerrainMaterial. The bits are ordered by priority, so
+// when materials overlap the larger value wins (Stone > Dirt > Magic).
+constexpr u8 kMaterialBits[kTerrainMaterialCount]{0x2, 0x4, 0x1};
+
+// Materials that take part in fluid collision
+constexpr u8 kSolidMask{0x2 | 0x4};
+
+// Nodes drawn by each material's render batch. Dirt also fills under stone so the stone edges
+// drawn on top never show a gap at a dirt/stone border.
+constexpr u8 kRenderMasks[kTerrainMaterialCount]{0x2 | 0x4, 0x4, 0x1};
+
+// Densities at or above this value count as a filled node
+constexpr u8 kDensityThreshold{128};
+
+// Chunk coordinate and local index of a node or cell coordinate
+constexpr u32 kChunkShift{5};
+constexpr u32 kChunkLocalMask{kTerrainChunkSize - 1};
+static_assert((1u << kChunkShift) == kTerrainChunkSize, "kChunkShift must match the chunk size");
+
+u8 materialBit(TerrainMaterial material) { return kMaterialBits[static_cast<u32>(material)]; }
+
+// Name of the material a node holds, for load-time logging
+const char* nodeMaterialName(u8 node) {
+    switch (node) {
+    case 0x1:
+        return "Magic";
+    case 0x2:
+        return "Dirt";
+    case 0x4:
+        return "Stone";
+    default:
+        return "Empty";
+    }
+}
+
+size_t localIndex(u32 row, u32 col) {
+    return static_cast<size_t>(row & kChunkLocalMask) * kTerrainChunkSize + (col & kChunkLocalMask);
+}
+
+// Offset from the midpoint of where the densities cross the threshold along an edge, a being the
+// density at -0.5 and b the one at +0.5. 0 if the edge does not cross.
+f32 edgeCrossing(u8 a, u8 b) {
+    if ((a >= kDensityThreshold) == (b >= kDensityThreshold))
+        return 0.0f;
+    const f32 iso{kDensityThreshold - 0.5f};
+    return (iso - a) / (static_cast<f32>(b) - a) - 0.5f;
+}
+
+// Mixed cases are the only ones with vertices on an edge
+bool hasEdgeVertices(u8 cellCase) { return cellCase != 0 && cellCase != 15; }
+} // namespace
+
+// =========================================================
+//
+// NodeBitPlane::resize
+//
+// Allocates a cleared plane. Each row is padded to a whole
+// number of 64-bit words and the padding bits stay zero.
+//
+// =========================================================
+void NodeBitPlane::resize(u32 rows, u32 cols) {
+    wordsPerRow_ = (cols + 63) / 64;
+    words_.assign(static_cast<size_t>(rows) * wordsPerRow_, 0);
+}
+
+// =========================================================
+//
+// NodeBitPlane::set
+//
+// Sets or clears the bit of a single node.
+//
+// =========================================================
+void NodeBitPlane::set(u32 row, u32 col, bool value) {
+    u64& word{words_[static_cast<size_t>(row) * wordsPerRow_ + (col >> 6)]};
+    const u64 bit{u64{1} << (col & 63)};
+    word = value ? (word | bit) : (word & ~bit);
+}
 
 // =========================================================
 //
 // Terrain::Terrain
 //
-// Constructs the terrain grid by initialising dimensions,
-// allocating cell and node vectors, and zeroing all nodes.
+// Constructs the terrain grid by initialising dimensions
+// and an empty table of chunks. No chunk is allocated
+// until a node inside it is filled.
 //
 // =========================================================
-Terrain::Terrain(TerrainMaterial terrainMaterial, AEGfxTexture* pTex, AEVec2 centerPosition,
-                 u32 cellRows, u32 cellCols, u32 cellSize, bool collidable)
-    : terrainMaterial_(terrainMaterial), kCellRows_(cellRows), kCellCols_(cellCols),
-      kCellSize_(cellSize), kNodeRows_(kCellRows_ + 1), kNodeCols_(kCellCols_ + 1),
-      cells_(kCellRows_ * kCellCols_), nodes_(kNodeRows_ * kNodeCols_), collidable_{collidable} {
+Terrain::Terrain(AEVec2 centerPosition, u32 cellRows, u32 cellCols, u32 cellSize)
+    : kCellRows_(cellRows), kCellCols_(cellCols), kCellSize_(cellSize),
+      kNodeRows_(kCellRows_ + 1), kNodeCols_(kCellCols_ + 1),
+      kChunkRows_((kNodeRows_ + kTerrainChunkSize - 1) / kTerrainChunkSize),
+      kChunkCols_((kNodeCols_ + kTerrainChunkSize - 1) / kTerrainChunkSize),
+      chunks_(static_cast<size_t>(kChunkRows_) * kChunkCols_) {
 
     transform_.pos_ = centerPosition;
 
-    graphics_.texture_ = pTex;
-
     // Calculate half the width and height of the whole terrain
     halfWidth_ = (static_cast<f32>(kCellCols_) * kCellSize_) / 2.0f;
     halfHeight_ = (static_cast<f32>(kCellRows_) * kCellSize_) / 2.0f;
 
     // Calculate the bottom-left corner of the terrain
     bottomLeftPos_ = {transform_.pos_.x - halfWidth_, transform_.pos_.y - halfHeight_};
+}
 
-    // Initialize nodes to random values for testing
-    for (u32 r{0}; r < kNodeRows_; ++r) {
-        for (u32 c{0}; c < kNodeCols_; ++c) {
-            nodes_[static_cast<size_t>(r) * kNodeCols_ + c] = 0.0f;
+// =========================================================
+//
+// Terrain::~Terrain
+//
+// Frees the baked meshes of every allocated chunk.
+//
+// =========================================================
+Terrain::~Terrain() {
+    for (std::unique_ptr<TerrainChunk>& chunk : chunks_) {
+        if (chunk == nullptr)
+            continue;
+
+        for (AEGfxVertexList*& mesh : chunk->meshes_) {
+            if (mesh != nullptr)
+                AEGfxMeshFree(mesh);
+            mesh = nullptr;
         }
     }
 }
 
 // =========================================================
 //
-// Terrain::initCellsTransform
+// Terrain::setTexture
 //
-// Sets the world position and scale for every cell based
-// on the terrain's bottom-left corner and cell size.
+// Sets the spritesheet atlas used by a material's render
+// batch.
 //
 // =========================================================
-void Terrain::initCellsTransform() {
-    for (u32 r{0}; r < kCellRows_; ++r) {
-        for (u32 c{0}; c < kCellCols_; ++c) {
-            Cell& cell = cells_[static_cast<size_t>(r) * kCellCols_ + c];
+void Terrain::setTexture(TerrainMaterial material, AEGfxTexture* pTex) {
+    textures_[static_cast<u32>(material)] = pTex;
+}
 
-            // Set position and scale
-            cell.transform_.pos_.x = bottomLeftPos_.x + (c + 0.5f) * kCellSize_;
-            cell.transform_.pos_.y = bottomLeftPos_.y + (r + 0.5f) * kCellSize_;
-            cell.transform_.scale_ = {(f32)kCellSize_, (f32)kCellSize_};
+// =========================================================
+//
+// Terrain::initCells
+//
+// Computes the 4-bit marching-squares case of every cell
+// from the solid materials at its four corner nodes. The
+// case alone selects the cell's colliders from the case
+// tables. Only allocated chunks are visited and each of
+// their rows is classified 32 cells at a time. With
+// densities enabled the edge crossings of the mixed cells
+// are interpolated as well. The time taken is kept for the
+// terrain stats HUD. A new generation is taken, which drops
+// every particle contact cached against the old cells.
+//
+// =========================================================
+void Terrain::initCells() {
+    const auto initStart = std::chrono::steady_clock::now();
+
+    // Every cell is classified below, so nothing queued is left to rebuild
+    hasPendingEdits_ = false;
+    generation_ = ++nextGeneration_;
+
+    for (u32 cr{0}; cr < kChunkRows_; ++cr) {
+        for (u32 cc{0}; cc < kChunkCols_; ++cc) {
+            TerrainChunk* chunk{getChunk(cr, cc)};
+            if (chunk == nullptr)
+                continue;
+
+            const GridRegion cells{getChunkCellRegion(cr, cc)};
+            for (u32 r{cells.minRow_}; r <= cells.maxRow_; ++r) {
+                classifyChunkRow(cr, cc, r - cells.minRow_, kSolidMask,
+                                 &chunk->cellCases_[localIndex(r, 0)]);
+                if (!densityEnabled_)
+                    continue;
+
+                for (u32 c{cells.minCol_}; c <= cells.maxCol_; ++c) {
+                    const size_t i{localIndex(r, c)};
+                    chunk->cellEdges_[i] = hasEdgeVertices(chunk->cellCases_[i])
+                                               ? computeCellEdges(r, c, kSolidMask)
+                                               : MarchingSquares::CellEdges{};
+                }
+            }
         }
     }
+
+    const std::chrono::duration<f32, std::milli> initTime =
+        std::chrono::steady_clock::now() - initStart;
+    initCellsTimeMs_ = initTime.count();
 }
 
 // =========================================================
 //
-// Terrain::initCellsGraphics
+// Terrain::getCellStorageBytes
 //
-// Assigns the correct mesh from the mesh library to each
-// cell by computing the 4-bit marching-squares node mask.
+// Sums the per-cell data of every allocated chunk: one
+// case byte per cell, and the edge crossings when
+// densities are enabled. Node planes and meshes are not
+// counted.
 //
 // =========================================================
-void Terrain::initCellsGraphics() {
-    for (u32 r{0}; r < kCellRows_; ++r) {
-        for (u32 c{0}; c < kCellCols_; ++c) {
-            // Determine mesh case (TL=8, TR=4, BR=2, BL=1)
-            u32 index{0};
-            if (nodes_[(static_cast<size_t>(r) + 1) * kNodeCols_ + c] >= threshold_)
-                index |= 8;
-            if (nodes_[(static_cast<size_t>(r) + 1) * kNodeCols_ + c + 1] >= threshold_)
-                index |= 4;
-            if (nodes_[static_cast<size_t>(r) * kNodeCols_ + c + 1] >= threshold_)
-                index |= 2;
-            if (nodes_[static_cast<size_t>(r) * kNodeCols_ + c] >= threshold_)
-                index |= 1;
-
-            cells_[static_cast<size_t>(r) * kCellCols_ + c].graphics_.mesh_ = meshLibrary_[index];
-        }
+size_t Terrain::getCellStorageBytes() const {
+    size_t bytes{0};
+    for (const auto& chunk : chunks_) {
+        if (chunk == nullptr)
+            continue;
+
+        bytes += sizeof(chunk->cellCases_);
+        bytes += chunk->cellEdges_.size() * sizeof(MarchingSquares::CellEdges);
     }
+    return bytes;
 }
 
 // =========================================================
 //
-// Terrain::initCellsCollider
+// Terrain::getCell
 //
-// Assigns colliders from the collider library to each cell
-// using the same 4-bit node mask. Skipped when collidable_
-// is false (leaves all colliders as Empty).
+// Builds the view of a cell from its grid coordinate and
+// solid case index. Cells of unallocated chunks are empty.
+// With densities enabled the colliders come from the
+// smooth table along with the cell's edge crossings.
 //
 // =========================================================
-void Terrain::initCellsCollider() {
-    for (u32 r{0}; r < kCellRows_; ++r) {
-        for (u32 c{0}; c < kCellCols_; ++c) {
-            u32 index{0};
-            // If collidable_ is false, keep index at 0 (no colliders)
-            if (collidable_ == true) {
-                // Determine collider case (TL=8, TR=4, BR=2, BL=1)
-                if (nodes_[static_cast<size_t>(r + 1) * kNodeCols_ + c] >= threshold_)
-                    index |= 8;
-                if (nodes_[static_cast<size_t>(r + 1) * kNodeCols_ + c + 1] >= threshold_)
-                    index |= 4;
-                if (nodes_[static_cast<size_t>(r) * kNodeCols_ + c + 1] >= threshold_)
-                    index |= 2;
-                if (nodes_[static_cast<size_t>(r) * kNodeCols_ + c] >= threshold_)
-                    index |= 1;
-            }
-
-            Cell& cell = cells_[static_cast<size_t>(r) * kCellCols_ + c];
-
-            // Assign the collider shape from the library
-            for (u32 i{0}; i < 3; ++i) {
-                cell.colliders_[i] = colliderLibrary_[index][i];
-            }
-        }
+Cell Terrain::getCell(size_t cellIndex) const {
+    const u32 r{static_cast<u32>(cellIndex / kCellCols_)};
+    const u32 c{static_cast<u32>(cellIndex % kCellCols_)};
+    const TerrainChunk* chunk{getChunk(r >> kChunkShift, c >> kChunkShift)};
+    const u8 colliderCase{chunk != nullptr ? chunk->cellCases_[localIndex(r, c)] : u8{0}};
+
+    Cell cell;
+    cell.pos_ = {bottomLeftPos_.x + (c + 0.5f) * kCellSize_,
+                 bottomLeftPos_.y + (r + 0.5f) * kCellSize_};
+    cell.size_ = static_cast<f32>(kCellSize_);
+    if (chunk != nullptr && densityEnabled_) {
+        cell.colliders_ = MarchingSquares::kSmoothCaseColliders[colliderCase].slots_;
+        cell.edges_ = chunk->cellEdges_[localIndex(r, c)];
+    } else {
+        cell.colliders_ = MarchingSquares::kCaseColliders[colliderCase];
     }
+    return cell;
 }
 
 // =========================================================
 //
-// Terrain::updateTerrain
+// Terrain::cellHasColliders
 //
-// Rebuilds the world matrix for every cell from its stored
-// position, rotation, and scale.
+// Returns true if the cell's solid case is not empty.
+// Cells of unallocated chunks are always empty.
 //
 // =========================================================
-void Terrain::updateTerrain() {
-    for (u32 r{0}; r < kCellRows_; ++r) {
-        for (u32 c{0}; c < kCellCols_; ++c) {
-            Cell& cell = cells_[static_cast<size_t>(r) * kCellCols_ + c];
-
-            AEMtx33 scaleMtx, rotMtx, transMtx;
-            AEMtx33Scale(&scaleMtx, cell.transform_.scale_.x, cell.transform_.scale_.y);
-            AEMtx33Rot(&rotMtx, cell.transform_.rotationRad_);
-            AEMtx33Trans(&transMtx, cell.transform_.pos_.x, cell.transform_.pos_.y);
+bool Terrain::cellHasColliders(size_t cellIndex) const {
+    const u32 r{static_cast<u32>(cellIndex / kCellCols_)};
+    const u32 c{static_cast<u32>(cellIndex % kCellCols_)};
+    const TerrainChunk* chunk{getChunk(r >> kChunkShift, c >> kChunkShift)};
+    return chunk != nullptr && chunk->cellCases_[localIndex(r, c)] != 0;
+}
 
-            // transform = trans * rot * scale
-            AEMtx33Concat(&cell.transform_.worldMtx_, &rotMtx, &scaleMtx);
-            AEMtx33Concat(&cell.transform_.worldMtx_, &transMtx, &cell.transform_.worldMtx_);
-        }
-    }
+// =========================================================
+//
+// Terrain::getChunkCellRegion
+//
+// Returns the cells covered by a chunk. The last chunk row
+// or column may only hold the grid's final row or column
+// of nodes, in which case the region is empty (min > max).
+//
+// =========================================================
+GridRegion Terrain::getChunkCellRegion(u32 chunkRow, u32 chunkCol) const {
+    GridRegion cells;
+    cells.minRow_ = chunkRow * kTerrainChunkSize;
+    cells.minCol_ = chunkCol * kTerrainChunkSize;
+    cells.maxRow_ = (std::min)(cells.minRow_ + kTerrainChunkSize, kCellRows_) - 1;
+    cells.maxCol_ = (std::min)(cells.minCol_ + kTerrainChunkSize, kCellCols_) - 1;
+    return cells;
 }
 
 // =========================================================
@@ -180,10 +311,11 @@ void Terrain::updateTerrain() {
 // Terrain::destroyAtMouse
 //
 // Converts the current mouse cursor position to world space
-// and forwards it to destroyTerrainRadius.
+// and carves a stroke of the given material from last
+// frame's cursor to it.
 //
 // =========================================================
-bool Terrain::destroyAtMouse(f32 radius) {
+bool Terrain::destroyAtMouse(TerrainMaterial material, f32 radius) {
     s32 screenX, screenY;
     AEInputGetCursorPosition(&screenX, &screenY);
 
@@ -191,7 +323,8 @@ bool Terrain::destroyAtMouse(f32 radius) {
     f32 worldX{static_cast<f32>(screenX) - (AEGfxGetWindowWidth() / 2.0f)};
     f32 worldY{(AEGfxGetWindowHeight() / 2.0f) - static_cast<f32>(screenY)};
 
-    return destroyTerrainRadius(worldX, worldY, radius);
+    AEVec2 cursor{worldX, worldY};
+    return destroyStroke(material, continueStroke(cursor, material, false), cursor, radius);
 }
 
 // =========================================================
@@ -199,10 +332,11 @@ bool Terrain::destroyAtMouse(f32 radius) {
 // Terrain::buildAtMouse
 //
 // Converts the current mouse cursor position to world space
-// and forwards it to buildTerrainRadius.
+// and fills a stroke of the given material from last
+// frame's cursor to it.
 //
 // =========================================================
-void Terrain::buildAtMouse(f32 radius) {
+void Terrain::buildAtMouse(TerrainMaterial material, f32 radius) {
     s32 screenX, screenY;
     AEInputGetCursorPosition(&screenX, &screenY);
 
@@ -210,452 +344,169 @@ void Terrain::buildAtMouse(f32 radius) {
     f32 worldX{static_cast<f32>(screenX) - (AEGfxGetWindowWidth() / 2.0f)};
     f32 worldY{(AEGfxGetWindowHeight() / 2.0f) - static_cast<f32>(screenY)};
 
-    buildTerrainRadius(worldX, worldY, radius);
+    AEVec2 cursor{worldX, worldY};
+    buildStroke(material, continueStroke(cursor, material, true), cursor, radius);
 }
 
 // =========================================================
 //
-// Terrain::renderTerrain
+// Terrain::destroyStroke
 //
-// Draws every cell using the terrain texture, offsetting
-// the UV per column and row to tile the spritesheet atlas.
+// Clears all nodes of the material within radius of the
+// segment between the two world positions. Returns true if
+// any node was changed.
 //
 // =========================================================
-void Terrain::renderTerrain() {
-    AEGfxSetRenderMode(AE_GFX_RM_TEXTURE);
-    AEGfxSetColorToMultiply(1.0f, 1.0f, 1.0f, 1.0f);
-    AEGfxSetColorToAdd(0.0f, 0.0f, 0.0f, 0.0f);
-    AEGfxSetBlendMode(AE_GFX_BM_BLEND);
-    AEGfxSetTransparency(1.0f);
-
-    /*
-    // Set the color of the cell
-    if (terrainMaterial_ == TerrainMaterial::Dirt) {
-        AEGfxSetColorToMultiply(0.59f, 0.39f, 0.29f, 1.0f);
-    } else if (terrainMaterial_ == TerrainMaterial::Stone) {
-        AEGfxSetColorToMultiply(0.28f, 0.28f, 0.32f, 1.0f);
-    } else {
-        // Magenta color if terrainMaterial_ was not set properly
-        AEGfxSetColorToMultiply(1.0f, 0.0f, 1.0f, 1.0f);
-    }
-
-    for (Cell& cell : cells_) {
-        AEGfxSetTransform(cell.transform_.worldMtx_.m);
-        AEGfxTextureSet(cell.graphics_.texture_, 0.0f, 0.0f);
-        AEGfxMeshDraw(cell.graphics_.mesh_, AE_GFX_MDM_TRIANGLES);
-    }
-    */
-
-    for (u32 y{0}; y < kCellRows_; ++y) {
-        for (u32 x{0}; x < kCellCols_; ++x) {
-            Cell& cell{cells_[static_cast<size_t>(y) * kCellCols_ + x]};
-
-            AEGfxSetTransform(cell.transform_.worldMtx_.m);
-            AEGfxTextureSet(graphics_.texture_, x * (1.0f / 16.0f), y * -(1.0f / 16.0f));
-            AEGfxMeshDraw(cell.graphics_.mesh_, AE_GFX_MDM_TRIANGLES);
-        }
-    }
+bool Terrain::destroyStroke(TerrainMaterial material, const AEVec2& from, const AEVec2& to,
+                            f32 radius) {
+    return stampCapsule(material, from, to, radius, false);
 }
 
 // =========================================================
 //
-// Terrain::createMeshLibrary
+// Terrain::buildStroke
 //
-// Builds all 16 marching-squares meshes and stores them in
-// the shared meshLibrary_ array. Each entry corresponds to
-// a unique combination of the four corner node bits.
+// Sets all nodes within radius of the segment between the
+// two world positions to the material, keeping nodes of a
+// higher priority material.
 //
 // =========================================================
-void Terrain::createMeshLibrary() {
-    // Corners (Positions)
-    constexpr f32 kXLeft{-0.5f}, kXRight{0.5f}, kYBottom{-0.5f}, kYTop{0.5f};
-
-    // Corners (Texture coordinates)
-    constexpr f32 kXTekXLeft{kXLeft * (1.0f / 16.0f) + (1 / 16.0f * 2.0f)};
-    constexpr f32 kXTekXRight{kXRight * (1.0f / 16.0f) + (1 / 16.0f * 2.0f)};
-    constexpr f32 kYTexBottom{kYBottom * -(1.0f / 16.0f) + (1 / 16.0f * 2.0f)};
-    constexpr f32 kYTexTop{kYTop * -(1.0f / 16.0f) + (1 / 16.0f * 2.0f)};
-
-    // Midpoints (Positions)
-    constexpr f32 kXMiddle{0.0f}, kYMiddle{0.0f};
-
-    // Midpoints (Texture coordinates)
-    constexpr f32 kXTekXMiddle{kXMiddle * (1.0f / 16.0f) + (1 / 16.0f * 2.0f)};
-    constexpr f32 kYTekXMiddle{kYMiddle * -(1.0f / 16.0f) + (1 / 16.0f * 2.0f)};
-
-    u32 color{0xFFFFFFFF};
-
-    for (u32 i{0}; i < 16; ++i) {
-        AEGfxMeshStart();
-        switch (i) {
-        case 0:
-            break; // Empty
-
-        case 1: // BL
-            AEGfxTriAdd(kXLeft, kYBottom, color, kXTekXLeft, kYTexBottom, kXMiddle, kYBottom, color,
-                        kXTekXMiddle, kYTexBottom, kXLeft, kYMiddle, color, kXTekXLeft,
-                        kYTekXMiddle);
-            break;
-
-        case 2: // BR
-            AEGfxTriAdd(kXRight, kYBottom, color, kXTekXRight, kYTexBottom, kXRight, kYMiddle,
-                        color, kXTekXRight, kYTekXMiddle, kXMiddle, kYBottom, color, kXTekXMiddle,
-                        kYTexBottom);
-            break;
-
-        case 3: // BL and BR (Bottom rectangle)
-            AEGfxTriAdd(kXLeft, kYBottom, color, kXTekXLeft, kYTexBottom, kXRight, kYBottom, color,
-                        kXTekXRight, kYTexBottom, kXLeft, kYMiddle, color, kXTekXLeft,
-                        kYTekXMiddle);
-            AEGfxTriAdd(kXRight, kYBottom, color, kXTekXRight, kYTexBottom, kXRight, kYMiddle,
-                        color, kXTekXRight, kYTekXMiddle, kXLeft, kYMiddle, color, kXTekXLeft,
-                        kYTekXMiddle);
-            break;
-
-        case 4: // TR
-            AEGfxTriAdd(kXRight, kYTop, color, kXTekXRight, kYTexTop, kXMiddle, kYTop, color,
-                        kXTekXMiddle, kYTexTop, kXRight, kYMiddle, color, kXTekXRight,
-                        kYTekXMiddle);
-            break;
-
-        case 5: // BL and TR
-            AEGfxTriAdd(kXLeft, kYBottom, color, kXTekXLeft, kYTexBottom, kXMiddle, kYBottom, color,
-                        kXTekXMiddle, kYTexBottom, kXLeft, kYMiddle, color, kXTekXLeft,
-                        kYTekXMiddle);
-            AEGfxTriAdd(kXRight, kYTop, color, kXTekXRight, kYTexTop, kXMiddle, kYTop, color,
-                        kXTekXMiddle, kYTexTop, kXRight, kYMiddle, color, kXTekXRight,
-                        kYTekXMiddle);
-            break;
-
-        case 6: // BR and TR (Right rectangle)
-            AEGfxTriAdd(kXMiddle, kYBottom, color, kXTekXMiddle, kYTexBottom, kXRight, kYBottom,
-                        color, kXTekXRight, kYTexBottom, kXMiddle, kYTop, color, kXTekXMiddle,
-                        kYTexTop);
-            AEGfxTriAdd(kXRight, kYBottom, color, kXTekXRight, kYTexBottom, kXRight, kYTop, color,
-                        kXTekXRight, kYTexTop, kXMiddle, kYTop, color, kXTekXMiddle, kYTexTop);
-            break;
-
-        case 7: // BL, BR, and TR
-            AEGfxTriAdd(kXLeft, kYBottom, color, kXTekXLeft, kYTexBottom, kXRight, kYBottom, color,
-                        kXTekXRight, kYTexBottom, kXLeft, kYMiddle, color, kXTekXLeft,
-                        kYTekXMiddle);
-            AEGfxTriAdd(kXRight, kYBottom, color, kXTekXRight, kYTexBottom, kXRight, kYTop, color,
-                        kXTekXRight, kYTexTop, kXLeft, kYMiddle, color, kXTekXLeft, kYTekXMiddle);
-            AEGfxTriAdd(kXRight, kYTop, color, kXTekXRight, kYTexTop, kXMiddle, kYTop, color,
-                        kXTekXMiddle, kYTexTop, kXLeft, kYMiddle, color, kXTekXLeft, kYTekXMiddle);
-            break;
-
-        case 8: // TL
-            AEGfxTriAdd(kXLeft, kYTop, color, kXTekXLeft, kYTexTop, kXLeft, kYMiddle, color,
-                        kXTekXLeft, kYTekXMiddle, kXMiddle, kYTop, color, kXTekXMiddle, kYTexTop);
-            break;
-
-        case 9: // BL and TL (Left rectangle)
-            AEGfxTriAdd(kXLeft, kYBottom, color, kXTekXLeft, kYTexBottom, kXMiddle, kYBottom, color,
-                        kXTekXMiddle, kYTexBottom, kXLeft, kYTop, color, kXTekXLeft, kYTexTop);
-            AEGfxTriAdd(kXMiddle, kYBottom, color, kXTekXMiddle, kYTexBottom, kXMiddle, kYTop,
-                        color, kXTekXMiddle, kYTexTop, kXLeft, kYTop, color, kXTekXLeft, kYTexTop);
-            break;
-
-        case 10: // BR and TL
-            AEGfxTriAdd(kXRight, kYBottom, color, kXTekXRight, kYTexBottom, kXRight, kYMiddle,
-                        color, kXTekXRight, kYTekXMiddle, kXMiddle, kYBottom, color, kXTekXMiddle,
-                        kYTexBottom);
-            AEGfxTriAdd(kXLeft, kYTop, color, kXTekXLeft, kYTexTop, kXLeft, kYMiddle, color,
-                        kXTekXLeft, kYTekXMiddle, kXMiddle, kYTop, color, kXTekXMiddle, kYTexTop);
-            break;
-
-        case 11: // BL, BR, and TL
-            AEGfxTriAdd(kXLeft, kYBottom, color, kXTekXLeft, kYTexBottom, kXRight, kYBottom, color,
-                        kXTekXRight, kYTexBottom, kXLeft, kYTop, color, kXTekXLeft, kYTexTop);
-            AEGfxTriAdd(kXRight, kYBottom, color, kXTekXRight, kYTexBottom, kXRight, kYMiddle,
-                        color, kXTekXRight, kYTekXMiddle, kXLeft, kYTop, color, kXTekXLeft,
-                        kYTexTop);
-            AEGfxTriAdd(kXRight, kYMiddle, color, kXTekXRight, kYTekXMiddle, kXMiddle, kYTop, color,
-                        kXTekXMiddle, kYTexTop, kXLeft, kYTop, color, kXTekXLeft, kYTexTop);
-            break;
-
-        case 12: // TR and TL (Top rectangle)
-            AEGfxTriAdd(kXLeft, kYMiddle, color, kXTekXLeft, kYTekXMiddle, kXRight, kYMiddle, color,
-                        kXTekXRight, kYTekXMiddle, kXLeft, kYTop, color, kXTekXLeft, kYTexTop);
-            AEGfxTriAdd(kXRight, kYMiddle, color, kXTekXRight, kYTekXMiddle, kXRight, kYTop, color,
-                        kXTekXRight, kYTexTop, kXLeft, kYTop, color, kXTekXLeft, kYTexTop);
-            break;
-
-        case 13: // BL, TR, and TL
-            AEGfxTriAdd(kXLeft, kYBottom, color, kXTekXLeft, kYTexBottom, kXMiddle, kYBottom, color,
-                        kXTekXMiddle, kYTexBottom, kXLeft, kYTop, color, kXTekXLeft, kYTexTop);
-            AEGfxTriAdd(kXMiddle, kYBottom, color, kXTekXMiddle, kYTexBottom, kXRight, kYMiddle,
-                        color, kXTekXRight, kYTekXMiddle, kXLeft, kYTop, color, kXTekXLeft,
-                        kYTexTop);
-            AEGfxTriAdd(kXRight, kYMiddle, color, kXTekXRight, kYTekXMiddle, kXRight, kYTop, color,
-                        kXTekXRight, kYTexTop, kXLeft, kYTop, color, kXTekXLeft, kYTexTop);
-            break;
-
-        case 14: // BR, TR, and TL
-            AEGfxTriAdd(kXMiddle, kYBottom, color, kXTekXMiddle, kYTexBottom, kXRight, kYBottom,
-                        color, kXTekXRight, kYTexBottom, kXLeft, kYMiddle, color, kXTekXLeft,
-                        kYTekXMiddle);
-            AEGfxTriAdd(kXRight, kYBottom, color, kXTekXRight, kYTexBottom, kXRight, kYTop, color,
-                        kXTekXRight, kYTexTop, kXLeft, kYMiddle, color, kXTekXLeft, kYTekXMiddle);
-            AEGfxTriAdd(kXRight, kYTop, color, kXTekXRight, kYTexTop, kXLeft, kYTop, color,
-                        kXTekXLeft, kYTexTop, kXLeft, kYMiddle, color, kXTekXLeft, kYTekXMiddle);
-            break;
-
-        case 15: // Full square
-            AEGfxTriAdd(kXLeft, kYBottom, color, kXTekXLeft, kYTexBottom, kXRight, kYBottom, color,
-                        kXTekXRight, kYTexBottom, kXLeft, kYTop, color, kXTekXLeft, kYTexTop);
-            AEGfxTriAdd(kXRight, kYBottom, color, kXTekXRight, kYTexBottom, kXRight, kYTop, color,
-                        kXTekXRight, kYTexTop, kXLeft, kYTop, color, kXTekXLeft, kYTexTop);
-            break;
-        }
-        meshLibrary_[i] = AEGfxMeshEnd();
-    }
+void Terrain::buildStroke(TerrainMaterial material, const AEVec2& from, const AEVec2& to,
+                          f32 radius) {
+    stampCapsule(material, from, to, radius, true);
 }
 
 // =========================================================
 //
-// Terrain::freeMeshLibrary
+// Terrain::renderTerrain
+//
+// Draws every visible chunk with one draw call per
+// material batch. The chunk meshes already hold world
+// positions and atlas UVs, so the transform is the
+// identity and the texture offset is zero.
 //
-// Frees all 16 GPU meshes stored in meshLibrary_.
+// The list of optimisations include:
+//  - One draw per chunk and material replaces one
+//    transform, texture bind and draw per cell, so a full
+//    screen of terrain costs tens of draw calls instead
+//    of thousands.
+//  - Meshes are only rebaked for chunks whose nodes have
+//    changed since the last bake.
+//  - Unallocated chunks hold no terrain and are skipped.
+//  - Chunks outside the window are skipped (and not
+//    rebaked), so the cost follows what is on screen
+//    rather than the map size.
 //
 // =========================================================
-void Terrain::freeMeshLibrary() {
-    for (auto& mesh : meshLibrary_) {
-        AEGfxMeshFree(mesh);
+void Terrain::renderTerrain() {
+    AEGfxSetRenderMode(AE_GFX_RM_TEXTURE);
+    AEGfxSetColorToMultiply(1.0f, 1.0f, 1.0f, 1.0f);
+    AEGfxSetColorToAdd(0.0f, 0.0f, 0.0f, 0.0f);
+    AEGfxSetBlendMode(AE_GFX_BM_BLEND);
+    AEGfxSetTransparency(1.0f);
+
+    const f32 chunkWorldSize{static_cast<f32>(kCellSize_) * kTerrainChunkSize};
+
+    // Chunks overlapping the window, clamped to the grid
+    const f32 winMinCol{std::floor((AEGfxGetWinMinX() - bottomLeftPos_.x) / chunkWorldSize)};
+    const f32 winMaxCol{std::floor((AEGfxGetWinMaxX() - bottomLeftPos_.x) / chunkWorldSize)};
+    const f32 winMinRow{std::floor((AEGfxGetWinMinY() - bottomLeftPos_.y) / chunkWorldSize)};
+    const f32 winMaxRow{std::floor((AEGfxGetWinMaxY() - bottomLeftPos_.y) / chunkWorldSize)};
+    if (winMaxCol < 0.0f || winMaxRow < 0.0f || winMinCol >= static_cast<f32>(kChunkCols_) ||
+        winMinRow >= static_cast<f32>(kChunkRows_))
+        return;
+
+    const u32 minChunkCol{static_cast<u32>((std::max)(winMinCol, 0.0f))};
+    const u32 minChunkRow{static_cast<u32>((std::max)(winMinRow, 0.0f))};
+    const u32 maxChunkCol{(std::min)(static_cast<u32>(winMaxCol), kChunkCols_ - 1)};
+    const u32 maxChunkRow{(std::min)(static_cast<u32>(winMaxRow), kChunkRows_ - 1)};
+
+    // Bring the visible chunks' meshes up to date
+    for (u32 cr{minChunkRow}; cr <= maxChunkRow; ++cr) {
+        for (u32 cc{minChunkCol}; cc <= maxChunkCol; ++cc) {
+            TerrainChunk* chunk{getChunk(cr, cc)};
+            if (chunk != nullptr && chunk->meshDirty_)
+                bakeChunkMeshes(cr, cc, *chunk);
+        }
+    }
+
+    AEMtx33 identity;
+    AEMtx33Identity(&identity);
+    AEGfxSetTransform(identity.m);
+
+    // One batch per material, drawn in enum order (Dirt, Stone, Magic)
+    for (u32 material{0}; material < kTerrainMaterialCount; ++material) {
+        AEGfxTextureSet(textures_[material], 0.0f, 0.0f);
+
+        for (u32 cr{minChunkRow}; cr <= maxChunkRow; ++cr) {
+            for (u32 cc{minChunkCol}; cc <= maxChunkCol; ++cc) {
+                const TerrainChunk* chunk{getChunk(cr, cc)};
+                if (chunk != nullptr && chunk->meshes_[material] != nullptr)
+                    AEGfxMeshDraw(chunk->meshes_[material], AE_GFX_MDM_TRIANGLES);
+            }
+        }
     }
 }
 
 // =========================================================
 //
-// Terrain::createColliderLibrary
+// Terrain::bakeChunkMeshes
 //
-// Populates colliderLibrary_ with up to three collider
-// shapes per marching-squares case (box or triangle),
-// matching the geometry built by createMeshLibrary.
+// Classifies every cell of a chunk against each material's
+// render mask and bakes the triangles into one mesh per
+// material. Materials with no triangles in the chunk get
+// no mesh at all. With densities enabled the mixed cells
+// are interpolated against the same mask.
 //
 // =========================================================
-void Terrain::createColliderLibrary() {
-
-    // Corners
-    constexpr f32 kXLeft{-0.5f}, kXRight{0.5f}, kYBottom{-0.5f}, kYTop{0.5f};
-
-    // Midpoints
-    constexpr f32 kXMiddle{0.0f}, kYMiddle{0.0f};
+void Terrain::bakeChunkMeshes(u32 chunkRow, u32 chunkCol, TerrainChunk& chunk) {
+    const f32 cellSize{static_cast<f32>(kCellSize_)};
+    const GridRegion cells{getChunkCellRegion(chunkRow, chunkCol)};
+    const u32 color{0xFFFFFFFF};
+
+    const u32 count{cells.maxCol_ - cells.minCol_ + 1};
+
+    u8 rowCases[kTerrainChunkSize];
+    MarchingSquares::CellEdges rowEdges[kTerrainChunkSize];
+
+    for (u32 material{0}; material < kTerrainMaterialCount; ++material) {
+        bakeVertices_.clear();
+        for (u32 y{cells.minRow_}; y <= cells.maxRow_; ++y) {
+            classifyChunkRow(chunkRow, chunkCol, y - cells.minRow_, kRenderMasks[material],
+                             rowCases);
+            if (densityEnabled_) {
+                for (u32 i{0}; i < count; ++i) {
+                    const u32 x{cells.minCol_ + i};
+                    rowEdges[i] = hasEdgeVertices(rowCases[i])
+                                      ? computeCellEdges(y, x, kRenderMasks[material])
+                                      : MarchingSquares::CellEdges{};
+                }
+            }
+            TerrainMeshBuilder::appendRow(bakeVertices_, rowCases, count, y, cells.minCol_,
+                                          cellSize, bottomLeftPos_,
+                                          densityEnabled_ ? rowEdges : nullptr);
+        }
 
-    for (u32 i{0}; i < 16; ++i) {
-        // Reset all to empty first
-        for (u32 j{0}; j < 3; ++j) {
-            colliderLibrary_[i][j].colliderShape_ = ColliderShape::Empty;
+        AEGfxVertexList*& mesh{chunk.meshes_[material]};
+        if (mesh != nullptr) {
+            AEGfxMeshFree(mesh);
+            mesh = nullptr;
         }
+        if (bakeVertices_.empty())
+            continue;
 
-        u32 colliderCount{0};
-
-        switch (i) {
-        case 0:
-            break;
-
-        case 1: // BL
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXLeft,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXMiddle,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft,
-                                                                                    kYMiddle};
-            break;
-
-        case 2: // BR
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXRight,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXRight,
-                                                                                    kYMiddle};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXMiddle,
-                                                                                    kYBottom};
-            break;
-
-        case 3: // BL and BR (Bottom rectangle)
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Box;
-            colliderLibrary_[i][colliderCount].shapeData_.box_.offset_ = {0.0f, -0.25f};
-            colliderLibrary_[i][colliderCount].shapeData_.box_.size_ = {1.0f, 0.5f};
-            break;
-
-        case 4: // TR
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXRight, kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXMiddle,
-                                                                                    kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXRight,
-                                                                                    kYMiddle};
-            break;
-
-        case 5: // BL and TR
-            // BL
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXLeft,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXMiddle,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft,
-                                                                                    kYMiddle};
-            colliderCount++;
-            // TR
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXRight, kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXMiddle,
-                                                                                    kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXRight,
-                                                                                    kYMiddle};
-            break;
-
-        case 6: // BR and TR (Right rectangle)
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Box;
-            colliderLibrary_[i][colliderCount].shapeData_.box_.offset_ = {0.25f, 0.0f};
-            colliderLibrary_[i][colliderCount].shapeData_.box_.size_ = {0.5f, 1.0f};
-            break;
-
-        case 7: // BL, BR, and TR
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXLeft,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXRight,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft,
-                                                                                    kYMiddle};
-            colliderCount++;
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXRight,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXRight, kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft,
-                                                                                    kYMiddle};
-            colliderCount++;
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXRight, kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXMiddle,
-                                                                                    kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft,
-                                                                                    kYMiddle};
-            break;
-
-        case 8: // TL
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXLeft, kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXLeft,
-                                                                                    kYMiddle};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXMiddle,
-                                                                                    kYTop};
-            break;
-
-        case 9: // BL and TL (Left rectangle)
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Box;
-            colliderLibrary_[i][colliderCount].shapeData_.box_.offset_ = {-0.25f, 0.0f};
-            colliderLibrary_[i][colliderCount].shapeData_.box_.size_ = {0.5f, 1.0f};
-            break;
-
-        case 10: // BR and TL
-            // BR
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXRight,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXRight,
-                                                                                    kYMiddle};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXMiddle,
-                                                                                    kYBottom};
-            colliderCount++;
-            // TL
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXLeft, kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXLeft,
-                                                                                    kYMiddle};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXMiddle,
-                                                                                    kYTop};
-            break;
-
-        case 11: // BL, BR, and TL
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXLeft,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXRight,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft, kYTop};
-            colliderCount++;
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXRight,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXRight,
-                                                                                    kYMiddle};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft, kYTop};
-            colliderCount++;
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXRight,
-                                                                                    kYMiddle};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXMiddle,
-                                                                                    kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft, kYTop};
-            break;
-
-        case 12: // TR and TL (Top rectangle)
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Box;
-            colliderLibrary_[i][colliderCount].shapeData_.box_.offset_ = {0.0f, 0.25f};
-            colliderLibrary_[i][colliderCount].shapeData_.box_.size_ = {1.0f, 0.5f};
-            colliderCount++;
-            break;
-
-        case 13: // BL, TR, and TL
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXLeft,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXMiddle,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft, kYTop};
-            colliderCount++;
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXMiddle,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXRight,
-                                                                                    kYMiddle};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft, kYTop};
-            colliderCount++;
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXRight,
-                                                                                    kYMiddle};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXRight, kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft, kYTop};
-            break;
-
-        case 14: // BR, TR, and TL
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXMiddle,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXRight,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft,
-                                                                                    kYMiddle};
-            colliderCount++;
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXRight,
-                                                                                    kYBottom};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXRight, kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft,
-                                                                                    kYMiddle};
-            colliderCount++;
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Triangle;
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[0] = {kXRight, kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[1] = {kXLeft, kYTop};
-            colliderLibrary_[i][colliderCount].shapeData_.triangle_.vertices_[2] = {kXLeft,
-                                                                                    kYMiddle};
-            break;
-
-        case 15: // Full square
-            colliderLibrary_[i][colliderCount].colliderShape_ = ColliderShape::Box;
-            colliderLibrary_[i][colliderCount].shapeData_.box_.offset_ = {0.0f, 0.0f};
-            colliderLibrary_[i][colliderCount].shapeData_.box_.size_ = {1.0f, 1.0f};
-            colliderCount++;
-            break;
+        AEGfxMeshStart();
+        for (size_t v{0}; v + 2 < bakeVertices_.size(); v += 3) {
+            const TerrainVertex& a{bakeVertices_[v]};
+            const TerrainVertex& b{bakeVertices_[v + 1]};
+            const TerrainVertex& c{bakeVertices_[v + 2]};
+            AEGfxTriAdd(a.x_, a.y_, color, a.u_, a.v_, b.x_, b.y_, color, b.u_, b.v_, c.x_, c.y_,
+                        color, c.u_, c.v_);
         }
+        mesh = AEGfxMeshEnd();
     }
+
+    chunk.meshDirty_ = false;
 }
 
 // =========================================================
@@ -663,7 +514,7 @@ void Terrain::createColliderLibrary() {
 // Terrain::destroyTerrain
 //
 // Zeroes the node nearest to the given world position and
-// refreshes meshes, matrices, and colliders.
+// queues the cases of its four cells for a rebuild.
 //
 // =========================================================
 void Terrain::destroyTerrain(f32 worldX, f32 worldY) {
@@ -680,101 +531,615 @@ void Terrain::destroyTerrain(f32 worldX, f32 worldY) {
     if (col < kNodeCols_ && row < kNodeRows_) {
 
         // Update the node
-        nodes_[static_cast<size_t>(row) * kNodeCols_ + col] = 0.0f;
+        setNode(row, col, 0);
+        TerrainChunk* chunk{getChunk(row >> kChunkShift, col >> kChunkShift)};
+        if (chunk != nullptr && isDensityEnabled())
+            chunk->density_[localIndex(row, col)] = 0;
 
         // Update meshes
-        initCellsGraphics(); // Unoptimal as all cells are being updated
-        updateTerrain();
-        initCellsCollider();
-        markCollidersCacheDirty();
+        queueRebuild(GridRegion{row, col, row, col});
     }
 }
 
 // =========================================================
 //
-// Terrain::destroyTerrainRadius
+// Terrain::stampCapsule
+//
+// Builds or clears the material on all nodes within radius
+// of the segment between the two world positions, then
+// queues the affected cells for the next commit. Building keeps nodes
+// of a higher priority material and clearing only removes
+// nodes of the same material. A zero-length segment stamps
+// a plain circle. Returns true if any node was changed.
+//
+// With densities enabled the brush writes a soft rim: the
+// density falls from 255 at one cell inside the radius to
+// 128 on it and to 0 one cell outside, building keeps the
+// larger density and clearing the smaller one. A node's
+// material bit follows its density, so the cases stay
+// exactly the same as with plain bits, while a density
+// change alone still moves the surrounding edge crossings
+// and so refreshes those cells too.
 //
-// Zeroes all nodes within a circular radius of the given
-// world position, then refreshes meshes and colliders.
-// Returns true if any node was changed.
+// The list of optimisations include:
+//  - Only the nodes inside the capsule's bounding box are
+//    visited instead of every node of the grid.
+//  - Only the cells around the changed nodes are rebuilt,
+//    so an edit costs proportional to the brush size
+//    instead of the map size.
+//  - The rebuild is queued, so several edits in one frame
+//    share a single pass in commitEdits.
+//  - A whole frame's mouse movement is one capsule, so a
+//    fast drag costs a single rebuild and leaves no gaps.
 //
 // =========================================================
-bool Terrain::destroyTerrainRadius(f32 worldX, f32 worldY, f32 radius) {
-    bool changed{false};
+bool Terrain::stampCapsule(TerrainMaterial material, const AEVec2& from, const AEVec2& to,
+                           f32 radius, bool build) {
+    // The density rim reaches one cell past the radius
+    const f32 cellSize{static_cast<f32>(kCellSize_)};
+    const f32 reach{isDensityEnabled() ? radius + cellSize : radius};
+
+    GridRegion brush;
+    if (!getNodeRegionInCapsule(from, to, reach, brush))
+        return false;
+
+    const f32 segX{to.x - from.x};
+    const f32 segY{to.y - from.y};
+    const f32 segLenSq{segX * segX + segY * segY};
 
-    for (u32 r{0}; r < kNodeRows_; ++r) {
-        for (u32 c{0}; c < kNodeCols_; ++c) {
+    const u8 bit{materialBit(material)};
+
+    bool changed{false};
+    bool reshaped{false}; // A density moved without changing its node
+    GridRegion dirty{brush.maxRow_, brush.maxCol_, brush.minRow_, brush.minCol_};
+
+    auto growDirty = [&dirty](u32 r, u32 c) {
+        dirty.minRow_ = (std::min)(dirty.minRow_, r);
+        dirty.minCol_ = (std::min)(dirty.minCol_, c);
+        dirty.maxRow_ = (std::max)(dirty.maxRow_, r);
+        dirty.maxCol_ = (std::max)(dirty.maxCol_, c);
+    };
+
+    for (u32 r{brush.minRow_}; r <= brush.maxRow_; ++r) {
+        for (u32 c{brush.minCol_}; c <= brush.maxCol_; ++c) {
             f32 nodeWorldX = bottomLeftPos_.x + (c * kCellSize_);
             f32 nodeWorldY = bottomLeftPos_.y + (r * kCellSize_);
 
+            // Closest point on the segment to the node
+            f32 t{0.0f};
+            if (segLenSq > 0.0f) {
+                t = ((nodeWorldX - from.x) * segX + (nodeWorldY - from.y) * segY) / segLenSq;
+                t = (std::max)(0.0f, (std::min)(t, 1.0f));
+            }
+
             // Pythagorean distance check
-            f32 dx = nodeWorldX - worldX;
-            f32 dy = nodeWorldY - worldY;
-            if ((dx * dx + dy * dy) <= (radius * radius)) {
-                size_t nodeIndex = static_cast<size_t>(r) * kNodeCols_ + c;
-                if (nodes_[nodeIndex] > 0.0f) {
-                    nodes_[nodeIndex] = 0.0f;
-                    changed = true;
+            f32 dx = nodeWorldX - (from.x + segX * t);
+            f32 dy = nodeWorldY - (from.y + segY * t);
+            f32 distSq = dx * dx + dy * dy;
+            if (distSq > reach * reach)
+                continue;
+
+            const u8 node{getNode(r, c)};
+
+            // Empty nodes (0) lose to every material when building
+            bool replace{build ? node < bit : node == bit};
+
+            if (isDensityEnabled()) {
+                // 128 on the radius, saturating one cell inside (255) and outside (0)
+                const f32 rim{(radius - std::sqrt(distSq)) / cellSize};
+                const f32 clamped{(std::max)(-1.0f, (std::min)(rim, 1.0f))};
+                const u8 brushDensity{static_cast<u8>(std::lround(127.5f + 127.5f * clamped))};
+
+                // Building may write a rim into an empty chunk, clearing never needs one
+                TerrainChunk* chunk{build ? &touchChunksForNode(r, c)
+                                          : getChunk(r >> kChunkShift, c >> kChunkShift)};
+                if (chunk == nullptr)
+                    continue;
+
+                u8& density{chunk->density_[localIndex(r, c)]};
+                const u8 previousDensity{density};
+                if (build && (node == bit || (node == 0 && brushDensity < kDensityThreshold))) {
+                    density = (std::max)(density, brushDensity);
+                } else if (build && replace && brushDensity >= kDensityThreshold) {
+                    density = brushDensity;
+                } else if (!build && (node == bit || node == 0)) {
+                    density = (std::min)(density, static_cast<u8>(255 - brushDensity));
+                }
+
+                // The bit only changes when the density crosses the threshold
+                const bool filled{density >= kDensityThreshold};
+                replace = build ? (replace && filled) : (replace && !filled);
+
+                if (!replace && density != previousDensity) {
+                    markChunksDirtyForNode(r, c);
+                    reshaped = true;
+                    growDirty(r, c);
                 }
+            } else if (distSq > radius * radius) {
+                replace = false;
+            }
+
+            if (replace) {
+                setNode(r, c, build ? bit : 0);
+                changed = true;
+
+                // Grow the dirty rectangle to include this node
+                growDirty(r, c);
             }
         }
     }
 
-    if (changed) {
+    if (changed || reshaped) {
         // std::cout << "terrain modified----------------------------\n";
-        initCellsGraphics();
-        updateTerrain();
-        initCellsCollider();
-        markCollidersCacheDirty();
+        queueRebuild(dirty);
     }
     return changed;
 }
 
 // =========================================================
 //
-// Terrain::buildTerrainRadius
+// Terrain::continueStroke
 //
-// Sets all nodes within a circular radius of the given
-// world position to 1.0, then refreshes meshes and
-// colliders if any node changed.
+// Returns the start of this frame's mouse stroke. If the
+// terrain was edited with the same material and action
+// (build or destroy) on the previous frame, the stroke
+// continues from that cursor position, otherwise it starts
+// at the current cursor. Releasing the button skips a frame
+// and switching brush or action changes the key, so either
+// one starts a fresh stroke.
 //
 // =========================================================
-void Terrain::buildTerrainRadius(f32 worldX, f32 worldY, f32 radius) {
-    bool changed{false};
+AEVec2 Terrain::continueStroke(const AEVec2& cursor, TerrainMaterial material, bool build) {
+    const u32 frame{AEFrameRateControllerGetFrameCount()};
+    const bool continues{strokeActive_ && frame == lastStrokeFrame_ + 1 &&
+                         material == lastStrokeMaterial_ && build == lastStrokeBuild_};
+    const AEVec2 from{continues ? lastStrokePos_ : cursor};
+
+    strokeActive_ = true;
+    lastStrokeFrame_ = frame;
+    lastStrokeMaterial_ = material;
+    lastStrokeBuild_ = build;
+    lastStrokePos_ = cursor;
+    return from;
+}
 
-    for (u32 r{0}; r < kNodeRows_; ++r) {
-        for (u32 c{0}; c < kNodeCols_; ++c) {
-            f32 nodeWorldX = bottomLeftPos_.x + (c * kCellSize_);
-            f32 nodeWorldY = bottomLeftPos_.y + (r * kCellSize_);
+// =========================================================
+//
+// Terrain::computeCellCase
+//
+// Returns the 4-bit marching-squares case of a cell from
+// its four corner nodes (TL=8, TR=4, BR=2, BL=1). A corner
+// counts as filled when its material bit is in the mask.
+//
+// =========================================================
+u8 Terrain::computeCellCase(u32 row, u32 col, u8 materialMask) const {
+    u8 index{0};
+    if (getNode(row + 1, col) & materialMask)
+        index |= 8;
+    if (getNode(row + 1, col + 1) & materialMask)
+        index |= 4;
+    if (getNode(row, col + 1) & materialMask)
+        index |= 2;
+    if (getNode(row, col) & materialMask)
+        index |= 1;
+    return index;
+}
 
-            // Pythagorean distance check
-            f32 dx = nodeWorldX - worldX;
-            f32 dy = nodeWorldY - worldY;
-            if ((dx * dx + dy * dy) <= (radius * radius)) {
-                nodes_[static_cast<size_t>(r) * kNodeCols_ + c] = 1.0f;
-                changed = true;
+// =========================================================
+//
+// Terrain::getNode
+//
+// Returns the material bit of the plane the node is set
+// in, or 0 if the node is empty.
+//
+// =========================================================
+u8 Terrain::getNode(u32 row, u32 col) const {
+    const TerrainChunk* chunk{getChunk(row >> kChunkShift, col >> kChunkShift)};
+    if (chunk == nullptr)
+        return 0;
+
+    for (u32 material{0}; material < kTerrainMaterialCount; ++material) {
+        if (chunk->planes_[material].get(row & kChunkLocalMask, col & kChunkLocalMask))
+            return kMaterialBits[material];
+    }
+    return 0;
+}
+
+// =========================================================
+//
+// Terrain::setNode
+//
+// Sets the node in the plane of the given material bit and
+// clears it in every other plane, so a node always holds
+// at most one material. A bit of 0 empties the node.
+// Filling a node allocates its chunk on first use, while
+// emptying a node of an unallocated chunk does nothing.
+//
+// =========================================================
+void Terrain::setNode(u32 row, u32 col, u8 bit) {
+    TerrainChunk* chunk{bit != 0 ? &touchChunksForNode(row, col)
+                                 : getChunk(row >> kChunkShift, col >> kChunkShift)};
+    if (chunk == nullptr)
+        return;
+
+    for (u32 material{0}; material < kTerrainMaterialCount; ++material) {
+        chunk->planes_[material].set(row & kChunkLocalMask, col & kChunkLocalMask,
+                                     kMaterialBits[material] == bit);
+    }
+    markChunksDirtyForNode(row, col);
+}
+
+// =========================================================
+//
+// Terrain::getChunk
+//
+// Returns the chunk at a chunk coordinate, or nullptr if
+// it is outside the grid or has not been allocated.
+//
+// =========================================================
+TerrainChunk* Terrain::getChunk(u32 chunkRow, u32 chunkCol) const {
+    if (chunkRow >= kChunkRows_ || chunkCol >= kChunkCols_)
+        return nullptr;
+    return chunks_[static_cast<size_t>(chunkRow) * kChunkCols_ + chunkCol].get();
+}
+
+// =========================================================
+//
+// Terrain::touchChunksForNode
+//
+// Returns the chunk owning a node, allocating it if
+// needed. A node on a chunk's bottom or left edge is also
+// a corner of cells owned by the chunks below and to the
+// left, so those are allocated too; this keeps every
+// non-empty cell inside an allocated chunk.
+//
+// =========================================================
+TerrainChunk& Terrain::touchChunksForNode(u32 row, u32 col) {
+    const u32 chunkRow{row >> kChunkShift};
+    const u32 chunkCol{col >> kChunkShift};
+    const bool onBottomEdge{chunkRow > 0 && (row & kChunkLocalMask) == 0};
+    const bool onLeftEdge{chunkCol > 0 && (col & kChunkLocalMask) == 0};
+
+    auto touch = [this](u32 cr, u32 cc) -> TerrainChunk& {
+        std::unique_ptr<TerrainChunk>& slot{chunks_[static_cast<size_t>(cr) * kChunkCols_ + cc]};
+        if (slot == nullptr) {
+            slot = std::make_unique<TerrainChunk>();
+            for (NodeBitPlane& plane : slot->planes_) {
+                plane.resize(kTerrainChunkSize, kTerrainChunkSize);
+            }
+            if (densityEnabled_) {
+                slot->density_.assign(kTerrainChunkSize * kTerrainChunkSize, 0);
+                slot->cellEdges_.resize(kTerrainChunkSize * kTerrainChunkSize);
             }
         }
+        return *slot;
+    };
+
+    if (onBottomEdge)
+        touch(chunkRow - 1, chunkCol);
+    if (onLeftEdge)
+        touch(chunkRow, chunkCol - 1);
+    if (onBottomEdge && onLeftEdge)
+        touch(chunkRow - 1, chunkCol - 1);
+    return touch(chunkRow, chunkCol);
+}
+
+// =========================================================
+//
+// Terrain::markChunksDirtyForNode
+//
+// Flags the chunk owning a node for a mesh rebake, along
+// with the chunks below and to the left when the node is
+// also a corner of their boundary cells.
+//
+// =========================================================
+void Terrain::markChunksDirtyForNode(u32 row, u32 col) {
+    const u32 chunkRow{row >> kChunkShift};
+    const u32 chunkCol{col >> kChunkShift};
+    const bool onBottomEdge{chunkRow > 0 && (row & kChunkLocalMask) == 0};
+    const bool onLeftEdge{chunkCol > 0 && (col & kChunkLocalMask) == 0};
+
+    auto mark = [this](u32 cr, u32 cc) {
+        if (TerrainChunk* chunk{getChunk(cr, cc)})
+            chunk->meshDirty_ = true;
+    };
+
+    mark(chunkRow, chunkCol);
+    if (onBottomEdge)
+        mark(chunkRow - 1, chunkCol);
+    if (onLeftEdge)
+        mark(chunkRow, chunkCol - 1);
+    if (onBottomEdge && onLeftEdge)
+        mark(chunkRow - 1, chunkCol - 1);
+}
+
+// =========================================================
+//
+// Terrain::getMaskedWord
+//
+// Returns one row of a chunk's nodes with a bit set for
+// every node whose material is in the mask. Bit i is the
+// node in local column i. Unallocated chunks read as 0.
+//
+// =========================================================
+u64 Terrain::getMaskedWord(const TerrainChunk* chunk, u32 localRow, u8 materialMask) {
+    if (chunk == nullptr)
+        return 0;
+
+    u64 masked{0};
+    for (u32 material{0}; material < kTerrainMaterialCount; ++material) {
+        if (kMaterialBits[material] & materialMask)
+            masked |= chunk->planes_[material].getWord(localRow, 0);
     }
+    return masked;
+}
 
-    if (changed) {
-        // std::cout << "terrain modified----------------------------\n";
-        initCellsGraphics();
-        updateTerrain();
-        initCellsCollider();
-        markCollidersCacheDirty();
+// =========================================================
+//
+// Terrain::classifyChunkRow
+//
+// Writes the marching-squares case of every cell in one
+// row of a chunk to outCases (one entry per cell in the
+// chunk's cell region). Bit i of the corner words below
+// belongs to the cell in local column i:
+//  - bl / tl are the node words of the bottom / top row,
+//    the top row of a chunk's last row coming from the
+//    chunk above.
+//  - br / tr are the same words shifted down by one, with
+//    the first node of the chunk to the right carried
+//    into bit 31.
+//
+// The list of optimisations include:
+//  - 32 cells are tested at once with a handful of integer
+//    operations instead of four node reads per cell.
+//  - Rows with no filled corner are written as case 0 and
+//    fully filled rows as case 15 without a bit loop.
+//  - Padding bits past the last node are always clear, so
+//    no edge masking is needed before the shifts.
+//
+// =========================================================
+void Terrain::classifyChunkRow(u32 chunkRow, u32 chunkCol, u32 localRow, u8 materialMask,
+                               u8* outCases) const {
+    const TerrainChunk* chunk{getChunk(chunkRow, chunkCol)};
+    const TerrainChunk* right{getChunk(chunkRow, chunkCol + 1)};
+
+    // The row above the chunk's last row lives in the chunks above
+    const bool topInAbove{localRow + 1 == kTerrainChunkSize};
+    const TerrainChunk* top{topInAbove ? getChunk(chunkRow + 1, chunkCol) : chunk};
+    const TerrainChunk* topRight{topInAbove ? getChunk(chunkRow + 1, chunkCol + 1) : right};
+    const u32 topRow{topInAbove ? 0 : localRow + 1};
+
+    const u64 bottomWord{getMaskedWord(chunk, localRow, materialMask)};
+    const u64 topWord{getMaskedWord(top, topRow, materialMask)};
+    const u64 rightBottom{getMaskedWord(right, localRow, materialMask) & 1};
+    const u64 rightTop{getMaskedWord(topRight, topRow, materialMask) & 1};
+
+    const u64 bl{bottomWord};
+    const u64 br{(bottomWord >> 1) | (rightBottom << (kTerrainChunkSize - 1))};
+    const u64 tl{topWord};
+    const u64 tr{(topWord >> 1) | (rightTop << (kTerrainChunkSize - 1))};
+
+    const GridRegion cells{getChunkCellRegion(chunkRow, chunkCol)};
+    const u32 count{cells.maxCol_ - cells.minCol_ + 1};
+    const u64 validMask{(u64{1} << count) - 1};
+
+    if (((bl | br | tl | tr) & validMask) == 0) {
+        std::fill(outCases, outCases + count, u8{0});
+    } else if ((bl & br & tl & tr & validMask) == validMask) {
+        std::fill(outCases, outCases + count, u8{15});
+    } else {
+        for (u32 i{0}; i < count; ++i) {
+            outCases[i] = static_cast<u8>(((tl >> i) & 1) << 3 | ((tr >> i) & 1) << 2 |
+                                          ((br >> i) & 1) << 1 | ((bl >> i) & 1));
+        }
     }
 }
 
 // =========================================================
 //
-// Terrain::isNearestNodeToMouseAtThreshold
+// Terrain::getNodeRegionInCapsule
+//
+// Computes the range of nodes covered by the bounding box
+// of a capsule brush, clamped to the grid. Returns false
+// if the brush does not overlap any node.
+//
+// =========================================================
+bool Terrain::getNodeRegionInCapsule(const AEVec2& from, const AEVec2& to, f32 radius,
+                                     GridRegion& outNodes) const {
+    const f32 cellSize{static_cast<f32>(kCellSize_)};
+
+    // Node indices covered by the brush, before clamping
+    const f32 minCol{std::ceil(((std::min)(from.x, to.x) - radius - bottomLeftPos_.x) / cellSize)};
+    const f32 maxCol{std::floor(((std::max)(from.x, to.x) + radius - bottomLeftPos_.x) / cellSize)};
+    const f32 minRow{std::ceil(((std::min)(from.y, to.y) - radius - bottomLeftPos_.y) / cellSize)};
+    const f32 maxRow{std::floor(((std::max)(from.y, to.y) + radius - bottomLeftPos_.y) / cellSize)};
+
+    const f32 lastCol{static_cast<f32>(kNodeCols_ - 1)};
+    const f32 lastRow{static_cast<f32>(kNodeRows_ - 1)};
+
+    if (maxCol < 0.0f || maxRow < 0.0f || minCol > lastCol || minRow > lastRow || minCol > maxCol ||
+        minRow > maxRow)
+        return false;
+
+    outNodes.minCol_ = static_cast<u32>((std::max)(minCol, 0.0f));
+    outNodes.maxCol_ = static_cast<u32>((std::min)(maxCol, lastCol));
+    outNodes.minRow_ = static_cast<u32>((std::max)(minRow, 0.0f));
+    outNodes.maxRow_ = static_cast<u32>((std::min)(maxRow, lastRow));
+    return true;
+}
+
+// =========================================================
+//
+// Terrain::rebuildCellsAroundNodes
+//
+// Recomputes the solid case of every cell that has a
+// corner in the given node region. A node touches the cells to its
+// lower-left, lower-right, upper-left and upper-right, so
+// the region is grown by one cell towards the bottom-left
+// and clamped to the grid. Meshes, colliders, occupancy
+// and matrices all follow from the case and, with
+// densities enabled, the cell's edge crossings, so nothing
+// else needs refreshing. Only the chunks under the region
+// are touched.
+//
+// =========================================================
+void Terrain::rebuildCellsAroundNodes(const GridRegion& nodes) {
+    const u32 minRow{nodes.minRow_ > 0 ? nodes.minRow_ - 1 : 0};
+    const u32 minCol{nodes.minCol_ > 0 ? nodes.minCol_ - 1 : 0};
+    const u32 maxRow{(std::min)(nodes.maxRow_, kCellRows_ - 1)};
+    const u32 maxCol{(std::min)(nodes.maxCol_, kCellCols_ - 1)};
+
+    ++editStats_.rebuilds_;
+    editStats_.cellsRebuilt_ += (maxRow - minRow + 1) * (maxCol - minCol + 1);
+
+    for (u32 r{minRow}; r <= maxRow; ++r) {
+        for (u32 c{minCol}; c <= maxCol; ++c) {
+            // Unallocated chunks have no filled corners, so their cells stay empty
+            TerrainChunk* chunk{getChunk(r >> kChunkShift, c >> kChunkShift)};
+            if (chunk == nullptr)
+                continue;
+
+            const size_t i{localIndex(r, c)};
+            chunk->cellCases_[i] = computeCellCase(r, c, kSolidMask);
+            if (densityEnabled_) {
+                chunk->cellEdges_[i] = hasEdgeVertices(chunk->cellCases_[i])
+                                           ? computeCellEdges(r, c, kSolidMask)
+                                           : MarchingSquares::CellEdges{};
+            }
+        }
+    }
+}
+
+// =========================================================
+//
+// Terrain::queueRebuild
+//
+// Merges an edited node region into the pending region.
+// Edits of one frame usually overlap (a stroke per
+// terrain, or build and destroy passes of the same
+// brush), so their bounding region costs little more
+// than the largest of them.
+//
+// =========================================================
+void Terrain::queueRebuild(const GridRegion& nodes) {
+    ++editStats_.editsQueued_;
+
+    if (!hasPendingEdits_) {
+        pendingNodes_ = nodes;
+        hasPendingEdits_ = true;
+        return;
+    }
+
+    pendingNodes_.minRow_ = (std::min)(pendingNodes_.minRow_, nodes.minRow_);
+    pendingNodes_.minCol_ = (std::min)(pendingNodes_.minCol_, nodes.minCol_);
+    pendingNodes_.maxRow_ = (std::max)(pendingNodes_.maxRow_, nodes.maxRow_);
+    pendingNodes_.maxCol_ = (std::max)(pendingNodes_.maxCol_, nodes.maxCol_);
+}
+
+// =========================================================
+//
+// Terrain::commitEdits
+//
+// Rebuilds the cells around every node edited since the
+// last commit in one pass, then clears the queue. Called
+// once per frame before the physics step; does nothing
+// when no edit is pending. The rebuild time is added to
+// the edit stats.
+//
+// =========================================================
+void Terrain::commitEdits() {
+    if (!hasPendingEdits_)
+        return;
+
+    const auto rebuildStart = std::chrono::steady_clock::now();
+    rebuildCellsAroundNodes(pendingNodes_);
+    hasPendingEdits_ = false;
+    const std::chrono::duration<f32, std::milli> rebuildTime =
+        std::chrono::steady_clock::now() - rebuildStart;
+    editStats_.rebuildTimeMs_ += rebuildTime.count();
+}
+
+// =========================================================
+//
+// Terrain::getMaterialNodes
+//
+// Expands one material into a float array with one value
+// per node (1.0 = filled, 0.0 = empty), the per-layer
+// format stored in level files. Only allocated chunks
+// are read.
+//
+// =========================================================
+std::vector<f32> Terrain::getMaterialNodes(TerrainMaterial material) const {
+    const u8 bit{materialBit(material)};
+
+    std::vector<f32> layerNodes(getNodeCount(), 0.0f);
+    for (u32 cr{0}; cr < kChunkRows_; ++cr) {
+        for (u32 cc{0}; cc < kChunkCols_; ++cc) {
+            if (!isChunkAllocated(cr, cc))
+                continue;
+
+            // Nodes owned by the chunk, clamped to the grid
+            const u32 maxRow{(std::min)((cr + 1) * kTerrainChunkSize, kNodeRows_)};
+            const u32 maxCol{(std::min)((cc + 1) * kTerrainChunkSize, kNodeCols_)};
+            for (u32 r{cr * kTerrainChunkSize}; r < maxRow; ++r) {
+                for (u32 c{cc * kTerrainChunkSize}; c < maxCol; ++c) {
+                    if (getNode(r, c) == bit)
+                        layerNodes[static_cast<size_t>(r) * kNodeCols_ + c] = 1.0f;
+                }
+            }
+        }
+    }
+    return layerNodes;
+}
+
+// =========================================================
+//
+// Terrain::setMaterialNodes
+//
+// Merges a per-layer float array from a level file into
+// the grid. Nodes at or above 1.0 become the material
+// unless they already hold a higher priority one, so the
+// layers can be merged in any order. Each node that was
+// filled in two layers is logged with the material it
+// dropped, since a node holds only one material. Call
+// initCells after all layers are merged.
+//
+// =========================================================
+void Terrain::setMaterialNodes(TerrainMaterial material, const std::vector<f32>& layerNodes) {
+    const u8 bit{materialBit(material)};
+    const size_t count{(std::min)(layerNodes.size(), getNodeCount())};
+
+    for (size_t i{0}; i < count; ++i) {
+        if (layerNodes[i] < 1.0f)
+            continue;
+
+        const u32 r{static_cast<u32>(i / kNodeCols_)};
+        const u32 c{static_cast<u32>(i % kNodeCols_)};
+        const u8 node{getNode(r, c)};
+        if (node != 0 && node != bit) {
+            const u8 kept{(std::max)(node, bit)};
+            const u8 dropped{(std::min)(node, bit)};
+            std::cout << "Terrain: node (" << r << ", " << c << ") is both "
+                      << nodeMaterialName(kept) << " and " << nodeMaterialName(dropped)
+                      << ", dropping " << nodeMaterialName(dropped) << "\n";
+        }
+        if (node < bit) {
+            setNode(r, c, bit);
+            if (isDensityEnabled())
+                getChunk(r >> kChunkShift, c >> kChunkShift)->density_[localIndex(r, c)] = 255;
+        }
+    }
+}
+
+// =========================================================
+//
+// Terrain::isNearestNodeToMouseMaterial
 //
 // Returns true if the node nearest to the current mouse
-// cursor is exactly at the threshold value.
+// cursor holds the given material.
 //
 // =========================================================
-bool Terrain::isNearestNodeToMouseAtThreshold() {
+bool Terrain::isNearestNodeToMouseMaterial(TerrainMaterial material) {
     s32 screenX{0}, screenY{0};
     AEInputGetCursorPosition(&screenX, &screenY);
 
@@ -787,7 +1152,193 @@ bool Terrain::isNearestNodeToMouseAtThreshold() {
     u32 col{static_cast<u32>(std::round(localX / kCellSize_))};
     u32 row{static_cast<u32>(std::round(localY / kCellSize_))};
     if (col < kNodeCols_ && row < kNodeRows_) {
-        return nodes_[static_cast<size_t>(row) * kNodeCols_ + col] == threshold_;
+        return getNode(row, col) == materialBit(material);
     }
     return false;
 }
+
+// =========================================================
+//
+// Terrain::isSolidAt
+//
+// Returns true if the node nearest to the world position
+// holds a material that fluid collides with (Dirt or
+// Stone). Positions outside the grid are not solid.
+//
+// =========================================================
+bool Terrain::isSolidAt(const AEVec2& worldPos) const {
+    const f32 cellSize{static_cast<f32>(kCellSize_)};
+    const f32 col{std::round((worldPos.x - bottomLeftPos_.x) / cellSize)};
+    const f32 row{std::round((worldPos.y - bottomLeftPos_.y) / cellSize)};
+    if (col < 0.0f || row < 0.0f || col >= static_cast<f32>(kNodeCols_) ||
+        row >= static_cast<f32>(kNodeRows_))
+        return false;
+
+    return (getNode(static_cast<u32>(row), static_cast<u32>(col)) & kSolidMask) != 0;
+}
+
+// =========================================================
+//
+// Terrain::setDensityEnabled
+//
+// Allocates or frees the per-node densities and the cell
+// edge crossings. Enabling seeds the densities from the
+// bit planes (255 filled, 0 empty), which cross exactly at
+// the edge midpoints, so the cases and the shapes do not
+// change until the next brush edit.
+//
+// =========================================================
+void Terrain::setDensityEnabled(bool enabled) {
+    densityEnabled_ = enabled;
+
+    for (u32 cr{0}; cr < kChunkRows_; ++cr) {
+        for (u32 cc{0}; cc < kChunkCols_; ++cc) {
+            TerrainChunk* chunk{getChunk(cr, cc)};
+            if (chunk == nullptr)
+                continue;
+
+            if (!enabled) {
+                chunk->density_.clear();
+                chunk->density_.shrink_to_fit();
+                chunk->cellEdges_.clear();
+                chunk->cellEdges_.shrink_to_fit();
+                continue;
+            }
+            if (!chunk->density_.empty())
+                continue;
+
+            chunk->density_.assign(kTerrainChunkSize * kTerrainChunkSize, 0);
+            chunk->cellEdges_.assign(kTerrainChunkSize * kTerrainChunkSize, {});
+            for (u32 r{0}; r < kTerrainChunkSize; ++r) {
+                for (u32 c{0}; c < kTerrainChunkSize; ++c) {
+                    for (const NodeBitPlane& plane : chunk->planes_) {
+                        if (plane.get(r, c))
+                            chunk->density_[localIndex(r, c)] = 255;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// =========================================================
+//
+// Terrain::getNodeDensity
+//
+// Returns the density of a node. Without densities a
+// filled node reads as 255 and an empty one as 0.
+//
+// =========================================================
+u8 Terrain::getNodeDensity(u32 row, u32 col) const {
+    const TerrainChunk* chunk{getChunk(row >> kChunkShift, col >> kChunkShift)};
+    if (chunk != nullptr && isDensityEnabled())
+        return chunk->density_[localIndex(row, col)];
+    return getNode(row, col) != 0 ? 255 : 0;
+}
+
+// =========================================================
+//
+// Terrain::getNodeDensities
+//
+// Expands the densities into one byte per node in
+// row-major order, the density layer stored in level
+// files. Nodes of unallocated chunks read as 0.
+//
+// =========================================================
+std::vector<u8> Terrain::getNodeDensities() const {
+    std::vector<u8> densities(getNodeCount(), 0);
+    for (u32 cr{0}; cr < kChunkRows_; ++cr) {
+        for (u32 cc{0}; cc < kChunkCols_; ++cc) {
+            if (!isChunkAllocated(cr, cc))
+                continue;
+
+            // Nodes owned by the chunk, clamped to the grid
+            const u32 maxRow{(std::min)((cr + 1) * kTerrainChunkSize, kNodeRows_)};
+            const u32 maxCol{(std::min)((cc + 1) * kTerrainChunkSize, kNodeCols_)};
+            for (u32 r{cr * kTerrainChunkSize}; r < maxRow; ++r) {
+                for (u32 c{cc * kTerrainChunkSize}; c < maxCol; ++c) {
+                    densities[static_cast<size_t>(r) * kNodeCols_ + c] = getNodeDensity(r, c);
+                }
+            }
+        }
+    }
+    return densities;
+}
+
+// =========================================================
+//
+// Terrain::setNodeDensities
+//
+// Writes a density layer from a level file back into the
+// allocated chunks. The node bits stay the source of
+// truth: a filled node keeps at least the threshold and an
+// empty one stays below it, so a layer saved from other
+// nodes cannot change any case. Call initCells afterwards
+// to place the edge crossings.
+//
+// =========================================================
+void Terrain::setNodeDensities(const std::vector<u8>& densities) {
+    if (!isDensityEnabled())
+        return;
+
+    const size_t count{(std::min)(densities.size(), getNodeCount())};
+    for (size_t i{0}; i < count; ++i) {
+        const u32 r{static_cast<u32>(i / kNodeCols_)};
+        const u32 c{static_cast<u32>(i % kNodeCols_)};
+        TerrainChunk* chunk{getChunk(r >> kChunkShift, c >> kChunkShift)};
+        if (chunk == nullptr)
+            continue;
+
+        chunk->density_[localIndex(r, c)] =
+            getNode(r, c) != 0 ? (std::max)(densities[i], kDensityThreshold)
+                               : (std::min)(densities[i], static_cast<u8>(kDensityThreshold - 1));
+    }
+}
+
+// =========================================================
+//
+// Terrain::getMaskedDensity
+//
+// Returns the density of a node as seen by the materials
+// in the mask. Empty nodes and nodes in the mask read
+// their own density, while a node of another material
+// reads 255 minus its density, so two materials meeting
+// share one crossing. The result is clamped to the node's
+// side of the threshold, keeping the crossing on edges
+// whose corners disagree.
+//
+// =========================================================
+u8 Terrain::getMaskedDensity(u32 row, u32 col, u8 materialMask) const {
+    const u8 node{getNode(row, col)};
+    const bool inside{(node & materialMask) != 0};
+
+    u8 density{getNodeDensity(row, col)};
+    if (node != 0 && !inside)
+        density = static_cast<u8>(255 - density);
+
+    return inside ? (std::max)(density, kDensityThreshold)
+                  : (std::min)(density, static_cast<u8>(kDensityThreshold - 1));
+}
+
+// =========================================================
+//
+// Terrain::computeCellEdges
+//
+// Returns where the masked densities cross the threshold
+// along each of a cell's four edges, by linear
+// interpolation between the edge's two corner nodes.
+//
+// =========================================================
+MarchingSquares::CellEdges Terrain::computeCellEdges(u32 row, u32 col, u8 materialMask) const {
+    const u8 bl{getMaskedDensity(row, col, materialMask)};
+    const u8 br{getMaskedDensity(row, col + 1, materialMask)};
+    const u8 tl{getMaskedDensity(row + 1, col, materialMask)};
+    const u8 tr{getMaskedDensity(row + 1, col + 1, materialMask)};
+
+    MarchingSquares::CellEdges edges;
+    edges.bottom_ = edgeCrossing(bl, br);
+    edges.right_ = edgeCrossing(br, tr);
+    edges.top_ = edgeCrossing(tl, tr);
+    edges.left_ = edgeCrossing(bl, tl);
+    return edges;
+}
@@ -0,0 +1,152 @@
+/*!
+@file       TerrainMeshBuilder.cpp
+@author     Sean Lee Hong Wei/seanhongwei.lee@digipen.edu
+@co_author  Woo Guang Theng/guangtheng.woo@digipen.edu
+
+@date		March, 31, 2026
+
+@brief      This source file contains the definitions of the CPU-side terrain
+            mesh builder, which places the compile-time case triangles in world
+            space and applies the atlas UV mapping used by the terrain spritesheets.
+
+@copyright  Copyright (C) 2026 DigiPen Institute of Technology.
+            Reproduction or disclosure of this file or its contents
+            without the prior written consent of DigiPen Institute of
+            Technology is prohibited.
+*//*______________________________________________________________________*/
+#include "TerrainMeshBuilder.h"
+
+// Standard library
+#include <vector>
+
+// Project
+#include "MarchingSquares.h"
+
+namespace {
+using MarchingSquares::CaseTriangles;
+using MarchingSquares::kCaseTriangles;
+
+// The spritesheet atlas is 16x16 tiles and wraps, so cell (row, col) samples tile (row % 16,
+// col % 16). The tile centre sits 2 tiles in from the atlas origin.
+constexpr u32 kAtlasTiles{16};
+constexpr f32 kAtlasTileUV{1.0f / kAtlasTiles};
+constexpr f32 kAtlasOriginUV{kAtlasTileUV * 2.0f};
+
+// Builds one baked vertex from a table vertex (in local cell units) of cell (row, col)
+constexpr TerrainVertex makeVertex(const AEVec2& local, u32 row, u32 col, f32 cellSize,
+                                   const AEVec2& gridBottomLeft) {
+    const f32 tileU{static_cast<f32>(col % kAtlasTiles)};
+    const f32 tileV{static_cast<f32>(row % kAtlasTiles)};
+
+    TerrainVertex vertex;
+    vertex.x_ = gridBottomLeft.x + (col + 0.5f) * cellSize + local.x * cellSize;
+    vertex.y_ = gridBottomLeft.y + (row + 0.5f) * cellSize + local.y * cellSize;
+    vertex.u_ = (local.x + tileU) * kAtlasTileUV + kAtlasOriginUV;
+    vertex.v_ = -(local.y + tileV) * kAtlasTileUV + kAtlasOriginUV;
+    return vertex;
+}
+
+// ==========================================
+//        Compile-time builder checks
+// ==========================================
+// Triangles appendCell emits per case: one per filled corner, two for a straight edge or a full
+// cell, three for one empty corner, and the saddle cases (5, 10) are two separate corners
+constexpr u32 kExpectedTriangles[16]{0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 2};
+
+// True if every case emits the expected number of counter-clockwise, non-degenerate triangles
+constexpr bool areCaseTrianglesValid() {
+    for (u32 cellCase{0}; cellCase < 16; ++cellCase) {
+        const CaseTriangles& triangles{kCaseTriangles[cellCase]};
+        if (triangles.count_ != kExpectedTriangles[cellCase])
+            return false;
+
+        for (u32 t{0}; t < triangles.count_; ++t) {
+            const AEVec2(&v)[3]{triangles.vertices_[t]};
+            if ((v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[1].y - v[0].y) * (v[2].x - v[0].x) <=
+                0.0f)
+                return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool isWhole(f32 value) { return static_cast<f32>(static_cast<s32>(value)) == value; }
+
+// True if cell (row, col) samples the same atlas texels as the old per-cell draw, which added the
+// offset (col / 16, -row / 16) to the unwrapped tile UVs. The wrapped UVs may only differ from
+// those by whole atlas widths, and must repeat every 16 cells.
+constexpr bool isAtlasWrapValid(u32 row, u32 col) {
+    constexpr AEVec2 kSamples[3]{{-0.5f, -0.5f}, {0.0f, 0.5f}, {0.5f, 0.0f}};
+    for (const AEVec2& local : kSamples) {
+        const TerrainVertex vertex{makeVertex(local, row, col, 1.0f, {0.0f, 0.0f})};
+        const TerrainVertex repeat{
+            makeVertex(local, row + kAtlasTiles, col + kAtlasTiles, 1.0f, {0.0f, 0.0f})};
+        const f32 oldU{local.x * kAtlasTileUV + kAtlasOriginUV + col * kAtlasTileUV};
+        const f32 oldV{-local.y * kAtlasTileUV + kAtlasOriginUV - row * kAtlasTileUV};
+        if (!isWhole(vertex.u_ - oldU) || !isWhole(vertex.v_ - oldV) ||
+            vertex.u_ != repeat.u_ || vertex.v_ != repeat.v_)
+            return false;
+    }
+    return true;
+}
+
+static_assert(areCaseTrianglesValid(),
+              "A marching-squares case emits the wrong triangle count or a back-facing triangle");
+static_assert(isAtlasWrapValid(0, 0) && isAtlasWrapValid(15, 15) && isAtlasWrapValid(16, 17) &&
+                  isAtlasWrapValid(37, 53) && isAtlasWrapValid(99, 99),
+              "Wrapped atlas UVs no longer sample the tiles of the per-cell atlas offset");
+} // namespace
+
+// =========================================================
+//
+// TerrainMeshBuilder::getTriangleCount
+//
+// Returns the number of triangles of a case's mesh.
+//
+// =========================================================
+u32 TerrainMeshBuilder::getTriangleCount(u8 cellCase) { return kCaseTriangles[cellCase & 15].count_; }
+
+// =========================================================
+//
+// TerrainMeshBuilder::appendCell
+//
+// Appends the triangles of one cell in world space. The
+// UVs follow the same mapping as drawing the cell with the
+// atlas offset (col / 16, -row / 16), but are wrapped to
+// the atlas so they stay small on large maps. Midpoint
+// vertices are moved to the given edge crossings, and the
+// UVs follow them so the texture does not stretch.
+//
+// =========================================================
+void TerrainMeshBuilder::appendCell(std::vector<TerrainVertex>& vertices, u8 cellCase, u32 row,
+                                    u32 col, f32 cellSize, const AEVec2& gridBottomLeft,
+                                    const MarchingSquares::CellEdges* edges) {
+    const CaseTriangles& triangles{kCaseTriangles[cellCase & 15]};
+    if (triangles.count_ == 0)
+        return;
+
+    for (u32 t{0}; t < triangles.count_; ++t) {
+        for (const AEVec2& tableVertex : triangles.vertices_[t]) {
+            const AEVec2 local{edges != nullptr ? MarchingSquares::placeVertex(tableVertex, *edges)
+                                                : tableVertex};
+            vertices.push_back(makeVertex(local, row, col, cellSize, gridBottomLeft));
+        }
+    }
+}
+
+// =========================================================
+//
+// TerrainMeshBuilder::appendRow
+//
+// Appends a run of consecutive cells of one row.
+//
+// =========================================================
+void TerrainMeshBuilder::appendRow(std::vector<TerrainVertex>& vertices, const u8* cellCases,
+                                   u32 count, u32 row, u32 firstCol, f32 cellSize,
+                                   const AEVec2& gridBottomLeft,
+                                   const MarchingSquares::CellEdges* cellEdges) {
+    for (u32 i{0}; i < count; ++i) {
+        appendCell(vertices, cellCases[i], row, firstCol + i, cellSize, gridBottomLeft,
+                   cellEdges != nullptr ? &cellEdges[i] : nullptr);
+    }
+}
@@ -0,0 +1,333 @@
+/*!
+@file       TriggerRegistry.cpp
+@author     Sean Lee Hong Wei/seanhongwei.lee@digipen.edu
+@co_author  Woo Guang Theng/guangtheng.woo@digipen.edu,
+            Chia Hanxin/c.hanxin@digipen.edu
+
+@date		March, 31, 2026
+
+@brief      This source file contains the definitions of the trigger volume
+            registry, which replaces the separate particle scans of the
+            portal, moss, collectible and start/end point systems with one
+            pass over the water pool per frame.
+
+@copyright  Copyright (C) 2026 DigiPen Institute of Technology.
+            Reproduction or disclosure of this file or its contents
+            without the prior written consent of DigiPen Institute of
+            Technology is prohibited.
+*//*______________________________________________________________________*/
+
+// ==========================================
+//               Includes
+// ==========================================
+#include "TriggerRegistry.h"
+
+// Standard library
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// Project
+#include "FluidSystem.h"
+
+// =========================================================
+//
+//  TriggerVolume's overlaps function
+//
+// Exact test of a particle collider against the volume
+// - Circle: squared centre distance against the squared sum of radii
+// - OrientedBox: rotates the particle into the box's local frame with
+//   the cached inverse rotation, then measures the distance to the
+//   closest point on the box
+//
+// =========================================================
+bool TriggerVolume::overlaps(const AEVec2& pos, f32 radius) const {
+    const f32 translatedX = pos.x - center_.x;
+    const f32 translatedY = pos.y - center_.y;
+
+    if (shape_ == TriggerShape::Circle) {
+        const f32 radiusSum = radius_ + radius;
+        return translatedX * translatedX + translatedY * translatedY < radiusSum * radiusSum;
+    }
+
+    const f32 localX = translatedX * cosAngle_ - translatedY * sinAngle_;
+    const f32 localY = translatedX * sinAngle_ + translatedY * cosAngle_;
+    const f32 dx = localX - (std::max)(-halfExtents_.x, (std::min)(localX, halfExtents_.x));
+    const f32 dy = localY - (std::max)(-halfExtents_.y, (std::min)(localY, halfExtents_.y));
+    return dx * dx + dy * dy < radius * radius;
+}
+
+// =========================================================
+//
+//  TriggerRegistry's addCircle function
+//
+// Registers a circular volume for this frame's pass
+//
+// =========================================================
+void TriggerRegistry::addCircle(TriggerSystem system, const AEVec2& center, f32 radius,
+                                ITriggerListener* listener, u32 tag) {
+    TriggerVolume volume;
+    volume.system_ = system;
+    volume.shape_ = TriggerShape::Circle;
+    volume.center_ = center;
+    volume.radius_ = radius;
+    volume.boundsMin_ = {center.x - radius, center.y - radius};
+    volume.boundsMax_ = {center.x + radius, center.y + radius};
+    volume.listener_ = listener;
+    volume.tag_ = tag;
+    volumes_.push_back(volume);
+}
+
+// =========================================================
+//
+//  TriggerRegistry's addOrientedBox function
+//
+// Registers a rotated box for this frame's pass
+// - Resolves the rotation to a cosine and sine once, so the pass never
+//   calls AECos/AESin
+// - An unrotated box skips the trig entirely and tests as an AABB
+//
+// =========================================================
+void TriggerRegistry::addOrientedBox(TriggerSystem system, const AEVec2& center,
+                                     const AEVec2& halfExtents, f32 rotationRad,
+                                     ITriggerListener* listener, u32 tag) {
+    if (rotationRad == 0.0f) {
+        addOrientedBox(system, center, halfExtents, 1.0f, 0.0f, listener, tag);
+        return;
+    }
+    addOrientedBox(system, center, halfExtents, AECos(rotationRad), AESin(rotationRad), listener,
+                   tag);
+}
+
+// =========================================================
+//
+//  TriggerRegistry's addOrientedBox function (cached rotation)
+//
+// Registers a rotated box whose rotation cosine and sine the caller
+// already holds
+// - Stores the inverse rotation the overlap test works in
+//
+// =========================================================
+void TriggerRegistry::addOrientedBox(TriggerSystem system, const AEVec2& center,
+                                     const AEVec2& halfExtents, f32 cosRotation, f32 sinRotation,
+                                     ITriggerListener* listener, u32 tag) {
+    TriggerVolume volume;
+    volume.system_ = system;
+    volume.shape_ = TriggerShape::OrientedBox;
+    volume.center_ = center;
+    volume.halfExtents_ = halfExtents;
+    // Undo the box's rotation
+    volume.cosAngle_ = cosRotation;
+    volume.sinAngle_ = -sinRotation;
+
+    // World bounding box of the rotated box
+    const f32 absCos = std::fabs(volume.cosAngle_);
+    const f32 absSin = std::fabs(volume.sinAngle_);
+    const f32 extentX = halfExtents.x * absCos + halfExtents.y * absSin;
+    const f32 extentY = halfExtents.x * absSin + halfExtents.y * absCos;
+    volume.boundsMin_ = {center.x - extentX, center.y - extentY};
+    volume.boundsMax_ = {center.x + extentX, center.y + extentY};
+    volume.listener_ = listener;
+    volume.tag_ = tag;
+    volumes_.push_back(volume);
+}
+
+// =========================================================
+//
+//  TriggerRegistry's consumeParticle function
+//
+// Claims a particle for removal at the end of the pass
+// - Only valid from inside a listener, while dispatch is running
+//
+// =========================================================
+void TriggerRegistry::consumeParticle(u32 particleIndex) {
+    if (consumedMask_[particleIndex])
+        return;
+    consumedMask_[particleIndex] = 1;
+    consumed_.push_back(particleIndex);
+}
+
+// =========================================================
+//
+//  TriggerRegistry's clear function
+//
+// Drops the registered volumes without running the pass
+//
+// =========================================================
+void TriggerRegistry::clear() { volumes_.clear(); }
+
+// =========================================================
+//
+//  TriggerRegistry's bucketVolumes function
+//
+// Inserts every awake volume into the fluid grid cells its bounds cover
+// - Bounds are grown by the largest particle radius, since a particle
+//   is looked up by the cell holding its centre
+// - Only the buckets filled here are cleared afterwards, so a large
+//   grid with a few volumes costs little
+//
+// =========================================================
+void TriggerRegistry::bucketVolumes(const FluidGrid& fluidGrid, f32 maxParticleRadius) {
+    if (buckets_.size() < fluidGrid.buckets_.size())
+        buckets_.resize(fluidGrid.buckets_.size());
+
+    const f32 invCellSize = 1.0f / fluidGrid.cellSize_;
+    const AEVec2& gridOrigin = fluidGrid.bottomLeftPos_;
+    const f32 lastCol = static_cast<f32>(fluidGrid.cols_ - 1);
+    const f32 lastRow = static_cast<f32>(fluidGrid.rows_ - 1);
+
+    for (u32 v : awakeVolumes_) {
+        const TriggerVolume& volume = volumes_[v];
+        const f32 minX = (volume.boundsMin_.x - maxParticleRadius - gridOrigin.x) * invCellSize;
+        const f32 maxX = (volume.boundsMax_.x + maxParticleRadius - gridOrigin.x) * invCellSize;
+        const f32 minY = (volume.boundsMin_.y - maxParticleRadius - gridOrigin.y) * invCellSize;
+        const f32 maxY = (volume.boundsMax_.y + maxParticleRadius - gridOrigin.y) * invCellSize;
+        if (maxX < 0.0f || maxY < 0.0f || minX > lastCol + 1.0f || minY > lastRow + 1.0f)
+            continue;
+
+        const u32 colBegin = static_cast<u32>((std::max)(std::floor(minX), 0.0f));
+        const u32 colEnd = static_cast<u32>((std::min)(std::floor(maxX), lastCol));
+        const u32 rowBegin = static_cast<u32>((std::max)(std::floor(minY), 0.0f));
+        const u32 rowEnd = static_cast<u32>((std::min)(std::floor(maxY), lastRow));
+        for (u32 row = rowBegin; row <= rowEnd; ++row) {
+            for (u32 col = colBegin; col <= colEnd; ++col) {
+                const u32 bucket = row * fluidGrid.cols_ + col;
+                if (buckets_[bucket].empty())
+                    touchedBuckets_.push_back(bucket);
+                buckets_[bucket].push_back(v);
+            }
+        }
+    }
+}
+
+// =========================================================
+//
+//  TriggerRegistry's dispatch function
+//
+// Runs the frame's single trigger pass over the water pool
+// - Wakes only the volumes that overlap the water pool's bounding box,
+//   and returns before the particle loop when none do
+// - Buckets the awake volumes into the fluid grid, then looks up each
+//   water particle's cell once and tests only the volumes bucketed there
+// - Particles outside the grid, or every particle when the grid was
+//   never sized, are tested against all awake volumes
+// - Dispatches each volume's hits to its listener in registration
+//   order, leaving out the particles consumed by earlier listeners
+// - Removes the consumed particles in one compaction at the end
+//
+// The list of optimisations include:
+// - The water pool is scanned once per frame instead of once per
+//   object in every trigger system
+// - Each particle only meets the volumes near it
+// - Objects far from all water (e.g. the collectibles of a level the
+//   water has not reached yet) cost nothing beyond their registration
+// - Particles outside the awake volumes' combined bounds skip the cell
+//   lookup
+// - Box rotations are resolved when the volume is registered
+//
+// =========================================================
+void TriggerRegistry::dispatch(FluidSystem& fluidSystem, const FluidGrid& fluidGrid,
+                               f32 maxParticleRadius, CollisionStats& stats) {
+    if (volumes_.empty())
+        return;
+
+    std::vector<FluidParticle>& particlePool = fluidSystem.getParticlePool(FluidType::Water);
+    const u32 volumeCount = static_cast<u32>(volumes_.size());
+    volumeChecks_.assign(volumeCount, 0);
+    hits_.clear();
+
+    // Bounding box of the water pool's colliders
+    AEVec2 waterMin{FLT_MAX, FLT_MAX};
+    AEVec2 waterMax{-FLT_MAX, -FLT_MAX};
+    for (const FluidParticle& particle : particlePool) {
+        const AEVec2& pos = particle.transform_.pos_;
+        waterMin.x = (std::min)(waterMin.x, pos.x);
+        waterMin.y = (std::min)(waterMin.y, pos.y);
+        waterMax.x = (std::max)(waterMax.x, pos.x);
+        waterMax.y = (std::max)(waterMax.y, pos.y);
+    }
+    waterMin.x -= maxParticleRadius;
+    waterMin.y -= maxParticleRadius;
+    waterMax.x += maxParticleRadius;
+    waterMax.y += maxParticleRadius;
+
+    // Wake the volumes the water can reach, and track their combined bounds
+    AEVec2 awakeMin{FLT_MAX, FLT_MAX};
+    AEVec2 awakeMax{-FLT_MAX, -FLT_MAX};
+    awakeVolumes_.clear();
+    for (u32 v = 0; v < volumeCount; ++v) {
+        const TriggerVolume& volume = volumes_[v];
+        if (volume.boundsMax_.x < waterMin.x || volume.boundsMin_.x > waterMax.x ||
+            volume.boundsMax_.y < waterMin.y || volume.boundsMin_.y > waterMax.y)
+            continue;
+        awakeVolumes_.push_back(v);
+        awakeMin.x = (std::min)(awakeMin.x, volume.boundsMin_.x - maxParticleRadius);
+        awakeMin.y = (std::min)(awakeMin.y, volume.boundsMin_.y - maxParticleRadius);
+        awakeMax.x = (std::max)(awakeMax.x, volume.boundsMax_.x + maxParticleRadius);
+        awakeMax.y = (std::max)(awakeMax.y, volume.boundsMax_.y + maxParticleRadius);
+    }
+    if (awakeVolumes_.empty()) {
+        volumes_.clear();
+        return;
+    }
+
+    const bool hasGrid = !fluidGrid.buckets_.empty();
+    if (hasGrid)
+        bucketVolumes(fluidGrid, maxParticleRadius);
+
+    auto test = [&](u32 v, u32 particleIndex, const FluidParticle& particle) {
+        ++volumeChecks_[v];
+        if (volumes_[v].overlaps(particle.transform_.pos_,
+                                 particle.collider_.shapeData_.circle_.radius_))
+            hits_.emplace_back(v, particleIndex);
+    };
+
+    const f32 invCellSize = hasGrid ? 1.0f / fluidGrid.cellSize_ : 0.0f;
+    const AEVec2& gridOrigin = fluidGrid.bottomLeftPos_;
+    for (u32 i = 0; i < static_cast<u32>(particlePool.size()); ++i) {
+        const FluidParticle& particle = particlePool[i];
+        const AEVec2& pos = particle.transform_.pos_;
+        if (pos.x < awakeMin.x || pos.x > awakeMax.x || pos.y < awakeMin.y || pos.y > awakeMax.y)
+            continue;
+        if (hasGrid) {
+            const s32 col = static_cast<s32>(std::floor((pos.x - gridOrigin.x) * invCellSize));
+            const s32 row = static_cast<s32>(std::floor((pos.y - gridOrigin.y) * invCellSize));
+            if (col >= 0 && col < static_cast<s32>(fluidGrid.cols_) && row >= 0 &&
+                row < static_cast<s32>(fluidGrid.rows_)) {
+                for (u32 v : buckets_[static_cast<size_t>(row) * fluidGrid.cols_ + col])
+                    test(v, i, particle);
+                continue;
+            }
+        }
+        for (u32 v : awakeVolumes_)
+            test(v, i, particle);
+    }
+
+    for (u32 bucket : touchedBuckets_)
+        buckets_[bucket].clear();
+    touchedBuckets_.clear();
+
+    // Group the hits by volume, particles stay ascending within a volume
+    std::sort(hits_.begin(), hits_.end());
+
+    consumedMask_.assign(particlePool.size(), 0);
+    consumed_.clear();
+    size_t next = 0;
+    for (u32 v = 0; v < volumeCount; ++v) {
+        volumeHits_.clear();
+        for (; next < hits_.size() && hits_[next].first == v; ++next) {
+            if (!consumedMask_[hits_[next].second])
+                volumeHits_.push_back(hits_[next].second);
+        }
+
+        const TriggerVolume& volume = volumes_[v];
+        stats.recordTriggerChecks(volume.system_, volumeChecks_[v],
+                                  static_cast<u32>(volumeHits_.size()));
+        if (volume.listener_ != nullptr && !volumeHits_.empty())
+            volume.listener_->onTriggerHits(volume.tag_, volumeHits_, *this, fluidSystem);
+    }
+
+    fluidSystem.removeParticles(FluidType::Water, consumed_);
+
+    volumes_.clear();
+}
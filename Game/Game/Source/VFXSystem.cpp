@@ -50,12 +50,13 @@
 //  VFXSystem's ParticleEmitter Initialize function
 //
 // Initializes a single ParticleEmitter with the inputted VFXType and position,
-// assigns its configuration from the preloaded emitter config array, spawns
-// its initial batch of particles, then immediately deactivates the emitter.
+// assigns its configuration from the preloaded emitter config array, scales
+// its burst size by countScale, spawns its initial batch of particles, then
+// immediately deactivates the emitter.
 //
 // =========================================================
 void VFXSystem::initializeEmitter(ParticleEmitter& emitter, VFXType type, AEVec2 pos,
-                                  f32 angleRad) {
+                                  f32 angleRad, f32 countScale) {
 
     emitter.active_ = true;
     emitter.type_ = type;
@@ -64,6 +65,10 @@ void VFXSystem::initializeEmitter(ParticleEmitter& emitter, VFXType type, AEVec2
     emitter.emitterLifeTime_ = 0.0f;
 
     emitter.config_ = emitterConfigs_[static_cast<int>(type)];
+    if (countScale != 1.0f) {
+        emitter.config_.spawnCount_ =
+            static_cast<int>(static_cast<f32>(emitter.config_.spawnCount_) * countScale + 0.5f);
+    }
 
     spawnParticles(emitter);
 
@@ -484,14 +489,15 @@ void VFXSystem::free() {
 // - Public entry point for triggering a one-shot VFX event at the given
 // world position.
 // - Retrieves a free emitter from the pool and initializes it with the requested type
+// - countScale multiplies the burst size, so a batch of hits can share one event
 //
 // - Logs a warning if no emitter is available.
 //
 // =========================================================
-void VFXSystem::spawnVFX(VFXType type, AEVec2 position, f32 angleRad) {
+void VFXSystem::spawnVFX(VFXType type, AEVec2 position, f32 angleRad, f32 countScale) {
     ParticleEmitter* emitter = getFreeEmitter();
     if (emitter != nullptr) {
-        initializeEmitter(*emitter, type, position, angleRad);
+        initializeEmitter(*emitter, type, position, angleRad, countScale);
     } else {
         std::cout << "Warning: No VFX Pools Available.";
     }